@@ -0,0 +1,436 @@
+/*
+	Entity system benchmark.
+
+	Usage: dpl_EntityBenchmark [--sizes 10000,100000,1000000] [--repeat 3] [--out results.json]
+
+	Each benchmark is run 'repeat' times for every size and the best time is reported.
+	Results are written as JSON (stdout by default), so that runs of different versions can be diffed.
+*/
+#include "dpl_EntityManager.h"
+#include "dpl_ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+// benchmark entities
+class	Body;
+class	Part;
+
+struct	Position
+{
+	float x, y, z;
+};
+
+struct	Velocity
+{
+	float x, y, z;
+};
+
+namespace dpl
+{
+	template<>
+	struct	Description_of<Body>
+	{
+		using BaseType			= Body;
+		using ParentTypes		= dpl::TypeList<>;
+		using ChildTypes		= dpl::TypeList<Part>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<Position, Velocity>;
+	};
+
+	template<>
+	struct	Description_of<Part>
+	{
+		using BaseType			= Part;
+		using ParentTypes		= dpl::TypeList<Body>;
+		using ChildTypes		= dpl::TypeList<>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<Position>;
+	};
+
+	template<>
+	struct	Relation_between<Body, Part> : public Relation<ONE_TO_MANY, STRONG_DEPENDENCY> {};
+}
+
+class	Body final : public dpl::Entity<Body>
+{
+public:		// [DATA]
+	uint32_t		counter = 0;
+
+public:		// [LIFECYCLE]
+	CLASS_CTOR		Body(				const dpl::Origin&	ORIGIN)
+		: Entity(ORIGIN)
+	{
+
+	}
+
+	CLASS_CTOR		Body(				Body&&				other) noexcept = default;
+	Body&			operator=(			Body&&				other) noexcept = default;
+
+public:		// [FUNCTIONS]
+	bool			attach(				Part&				part)
+	{
+		return Entity::add_child(part);
+	}
+
+	bool			detach(				Part&				part)
+	{
+		return Entity::remove_child(part);
+	}
+};
+
+class	Part final : public dpl::Entity<Part>
+{
+public:		// [LIFECYCLE]
+	CLASS_CTOR		Part(				const dpl::Origin&	ORIGIN)
+		: Entity(ORIGIN)
+	{
+
+	}
+
+	CLASS_CTOR		Part(				Part&&				other) noexcept = default;
+	Part&			operator=(			Part&&				other) noexcept = default;
+};
+
+
+// benchmark harness
+namespace
+{
+	using	Clock	= std::chrono::steady_clock;
+
+	struct	Result
+	{
+		std::string	name;
+		uint32_t	numEntities;
+		uint32_t	numThreads;
+		double		bestSeconds;
+	};
+
+	struct	Settings
+	{
+		std::vector<uint32_t>	sizes	= {10000, 100000, 1000000};
+		uint32_t				repeat	= 3;
+		std::string				outPath;
+	};
+
+	volatile uint64_t g_sink = 0; //<-- Prevents the compiler from removing measured loops.
+
+	std::string		entity_name(	const char*		PREFIX,
+									const uint32_t	INDEX)
+	{
+		return PREFIX + std::to_string(INDEX);
+	}
+
+	/*
+		Runs SETUP (not measured), then MEASURE, then TEARDOWN (not measured) 'repeat' times.
+		Each run uses a fresh world, so that runs do not share storage capacity.
+	*/
+	template<typename SetupT, typename MeasureT>
+	double			measure_best(	const Settings&	SETTINGS,
+									SetupT&&		setup,
+									MeasureT&&		measure)
+	{
+		double best = std::numeric_limits<double>::max();
+		for(uint32_t run = 0; run < SETTINGS.repeat; ++run)
+		{
+			dpl::Multition		world;
+			dpl::Logger			logger(world);
+			dpl::EntityManager	manager(world);
+
+			setup(manager);
+			const auto BEGIN = Clock::now();
+			measure(manager);
+			const auto END = Clock::now();
+			best = std::min(best, std::chrono::duration<double>(END - BEGIN).count());
+		}
+		return best;
+	}
+
+	void			create_bodies(	dpl::EntityManager&	manager,
+									const uint32_t		NUM_ENTITIES)
+	{
+		for(uint32_t index = 0; index < NUM_ENTITIES; ++index)
+		{
+			Body& body = manager.create<Body>(dpl::Name(dpl::Name::UNIQUE, entity_name("body", index)));
+			body.get_component<Velocity>() = {1.f, 2.f, 3.f};
+			body.get_component<Position>() = {0.f, 0.f, 0.f};
+		}
+	}
+
+	void			create_parts(	dpl::EntityManager&	manager,
+									const uint32_t		NUM_ENTITIES)
+	{
+		for(uint32_t index = 0; index < NUM_ENTITIES; ++index)
+		{
+			manager.create<Part>(dpl::Name(dpl::Name::UNIQUE, entity_name("part", index)));
+		}
+	}
+
+	void			attach_parts(	dpl::EntityManager&	manager)
+	{
+		dpl::EntityPack_of<Body>& bodies	= dpl::EntityPack_of<Body>::ref();
+		dpl::EntityPack_of<Part>& parts		= dpl::EntityPack_of<Part>::ref();
+		for(uint32_t index = 0; index < parts.size(); ++index)
+		{
+			bodies.get(index).attach(parts.get(index));
+		}
+	}
+
+	void			run_size(		const Settings&			SETTINGS,
+									const uint32_t			N,
+									std::vector<Result>&	results)
+	{
+		auto add = [&](const char* NAME, const uint32_t NUM_THREADS, const double SECONDS)
+		{
+			results.push_back({NAME, N, NUM_THREADS, SECONDS});
+			std::fprintf(stderr, "%-24s N=%-8u threads=%-3u %10.3f ms (%8.2f ns/entity)\n", NAME, N, NUM_THREADS, SECONDS * 1e3, SECONDS * 1e9 / N);
+		};
+
+		auto nothing = [](dpl::EntityManager&){};
+
+		add("create", 1, measure_best(SETTINGS, nothing, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+		}));
+
+		add("destroy_one_by_one", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			for(uint32_t index = N; index-- > 0;)
+			{
+				manager.destroy_at<Body>(index);
+			}
+		}));
+
+		add("for_each", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			manager.for_each<Body>([](Body& body)
+			{
+				Position&		position = body.get_component<Position>();
+				const Velocity&	VELOCITY = body.get_component<Velocity>();
+				position.x += VELOCITY.x;
+				position.y += VELOCITY.y;
+				position.z += VELOCITY.z;
+			});
+		}));
+
+		const uint32_t MAX_THREADS = std::max(1u, std::thread::hardware_concurrency());
+		for(uint32_t numThreads = 1; numThreads <= MAX_THREADS; numThreads = (numThreads == MAX_THREADS)? numThreads + 1 : std::min(numThreads * 2, MAX_THREADS))
+		{
+			std::unique_ptr<dpl::ParallelPhase> phase;
+			add("for_each_in_parallel", numThreads, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+			{
+				create_bodies(manager, N);
+				phase = std::make_unique<dpl::ParallelPhase>(numThreads);
+			},
+			[&](dpl::EntityManager& manager)
+			{
+				manager.for_each_in_parallel<Body>(*phase, [](Body& body)
+				{
+					Position&		position = body.get_component<Position>();
+					const Velocity&	VELOCITY = body.get_component<Velocity>();
+					position.x += VELOCITY.x;
+					position.y += VELOCITY.y;
+					position.z += VELOCITY.z;
+				});
+			}));
+		}
+
+		add("get_component", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			dpl::EntityPack_of<Body>& pack = dpl::EntityPack_of<Body>::ref();
+			float sum = 0.f;
+			for(uint32_t index = 0; index < pack.size(); ++index)
+			{
+				sum += pack.get(index).get_component<Velocity>().y;
+			}
+			g_sink = g_sink + (uint64_t)sum;
+		}));
+
+		std::vector<std::string> names;
+		add("find_by_name", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+			names.clear();
+			for(uint32_t index = 0; index < N; ++index)
+			{
+				names.push_back(entity_name("body", (index * 7919u) % N)); //<-- Shuffled order.
+			}
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			dpl::EntityPack_of<Body>& pack = dpl::EntityPack_of<Body>::ref();
+			uint64_t numFound = 0;
+			for(const std::string& NAME : names)
+			{
+				numFound += pack.find(NAME) != nullptr;
+			}
+			g_sink = g_sink + numFound;
+		}));
+
+		add("adopt", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+			create_parts(manager, N);
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			attach_parts(manager);
+		}));
+
+		add("orphan", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+			create_parts(manager, N);
+			attach_parts(manager);
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			dpl::EntityPack_of<Body>& bodies	= dpl::EntityPack_of<Body>::ref();
+			dpl::EntityPack_of<Part>& parts		= dpl::EntityPack_of<Part>::ref();
+			for(uint32_t index = 0; index < parts.size(); ++index)
+			{
+				bodies.get(index).detach(parts.get(index));
+			}
+		}));
+
+		add("destroy_hierarchy", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N / 2);
+			create_parts(manager, N / 2);
+			attach_parts(manager);
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			manager.destroy_all<Body>(); //<-- Parts strongly depend on bodies.
+		}));
+
+		dpl::BinaryState state;
+		add("save", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+			state = dpl::BinaryState();
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			dpl::EntityPack_of<Body>& pack = dpl::EntityPack_of<Body>::ref();
+			for(uint32_t index = 0; index < pack.size(); ++index)
+			{
+				pack.save_entity(pack.get(index), state);
+			}
+		}));
+
+		add("load", 1, measure_best(SETTINGS, [&](dpl::EntityManager& manager)
+		{
+			create_bodies(manager, N);
+			state = dpl::BinaryState();
+			dpl::EntityPack_of<Body>& pack = dpl::EntityPack_of<Body>::ref();
+			for(uint32_t index = 0; index < pack.size(); ++index)
+			{
+				pack.save_entity(pack.get(index), state);
+			}
+		},
+		[&](dpl::EntityManager& manager)
+		{
+			dpl::EntityPack_of<Body>& pack = dpl::EntityPack_of<Body>::ref();
+			for(uint32_t index = 0; index < pack.size(); ++index)
+			{
+				pack.load_entity(pack.get(index), state);
+			}
+		}));
+	}
+
+	void			write_json(		std::ostream&				stream,
+									const Settings&				SETTINGS,
+									const std::vector<Result>&	RESULTS)
+	{
+		stream << "{\n";
+		stream << "  \"repeat\": " << SETTINGS.repeat << ",\n";
+		stream << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+		stream << "  \"results\": [\n";
+		for(size_t index = 0; index < RESULTS.size(); ++index)
+		{
+			const Result& RESULT = RESULTS[index];
+			char line[256];
+			std::snprintf(line, sizeof(line), "    {\"name\": \"%s\", \"entities\": %u, \"threads\": %u, \"seconds\": %.9f, \"ns_per_entity\": %.3f}%s\n",
+						RESULT.name.c_str(), RESULT.numEntities, RESULT.numThreads, RESULT.bestSeconds,
+						RESULT.bestSeconds * 1e9 / RESULT.numEntities, (index + 1 < RESULTS.size())? "," : "");
+			stream << line;
+		}
+		stream << "  ]\n";
+		stream << "}\n";
+	}
+
+	bool			parse_arguments(const int		ARGC,
+									char**			argv,
+									Settings&		settings)
+	{
+		for(int index = 1; index < ARGC; ++index)
+		{
+			const bool HAS_VALUE = index + 1 < ARGC;
+			if(std::strcmp(argv[index], "--sizes") == 0 && HAS_VALUE)
+			{
+				settings.sizes.clear();
+				std::stringstream	list(argv[++index]);
+				std::string			item;
+				while(std::getline(list, item, ','))
+				{
+					settings.sizes.push_back((uint32_t)std::stoul(item));
+				}
+			}
+			else if(std::strcmp(argv[index], "--repeat") == 0 && HAS_VALUE)
+			{
+				settings.repeat = std::max(1u, (uint32_t)std::stoul(argv[++index]));
+			}
+			else if(std::strcmp(argv[index], "--out") == 0 && HAS_VALUE)
+			{
+				settings.outPath = argv[++index];
+			}
+			else
+			{
+				std::fprintf(stderr, "Usage: %s [--sizes 10000,100000,1000000] [--repeat 3] [--out results.json]\n", argv[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+	if(!parse_arguments(argc, argv, settings)) return 1;
+
+	std::vector<Result> results;
+	for(const uint32_t N : settings.sizes)
+	{
+		run_size(settings, N, results);
+	}
+
+	if(settings.outPath.empty())
+	{
+		write_json(std::cout, settings, results);
+	}
+	else
+	{
+		std::ofstream file(settings.outPath);
+		write_json(file, settings, results);
+	}
+	return 0;
+}
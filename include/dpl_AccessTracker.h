@@ -0,0 +1,314 @@
+#pragma once
+
+
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
+#include "dpl_ClassInfo.h"
+#include "dpl_GeneralException.h"
+
+
+namespace dpl
+{
+	/*
+		Labels every access declared by the calling thread until destroyed(e.g. with the name of the updated system).
+		Tasks added to the ThreadPool inherit the caller of the thread that added them.
+	*/
+	class	AccessCaller
+	{
+#ifdef _DEBUG
+	private: // data
+		static inline thread_local const char*	sm_current = nullptr;
+		const char*								m_previous;
+#endif // _DEBUG
+
+	public: // lifecycle
+		CLASS_CTOR			AccessCaller(	const char*			LABEL)
+#ifdef _DEBUG
+			: m_previous(sm_current)
+		{
+			sm_current = LABEL;
+		}
+
+		CLASS_DTOR			~AccessCaller()
+		{
+			sm_current = m_previous;
+		}
+#else
+		{
+
+		}
+#endif // _DEBUG
+
+		CLASS_CTOR			AccessCaller(	const AccessCaller&	OTHER) = delete;
+		AccessCaller&		operator=(		const AccessCaller&	OTHER) = delete;
+
+	public: // functions
+		static const char*	current()
+		{
+#ifdef _DEBUG
+			return sm_current;
+#else
+			return nullptr;
+#endif // _DEBUG
+		}
+	};
+
+
+#ifdef _DEBUG
+	/*
+		Detects conflicting concurrent access to the owner: any number of readers or a single writer.
+		Writer may nest its own read and write scopes, but a reader cannot be upgraded to a writer.
+		Access to a part of the owner(e.g. a single component of the row) is only checked against the scopes of other threads, it does not declare anything.
+		Conflicts throw dpl::GeneralException with labels and callers of both accesses(e.g. names of the functions and systems).
+	*/
+	class	AccessTracker
+	{
+	private: // data
+		mutable std::atomic<uint32_t>			m_numReaders;
+		mutable std::atomic<const char*>		m_readerLabel;	//<-- Label of the last reader.
+		mutable std::atomic<const char*>		m_readerCaller;
+		std::atomic<std::thread::id>			m_writer;
+		std::atomic<const char*>				m_writerLabel;
+		std::atomic<const char*>				m_writerCaller;
+		uint32_t								m_writeDepth;	//<-- Modified by the writer only.
+
+	public: // lifecycle
+		CLASS_CTOR			AccessTracker()
+			: m_numReaders(0)
+			, m_readerLabel(nullptr)
+			, m_readerCaller(nullptr)
+			, m_writer(std::thread::id())
+			, m_writerLabel(nullptr)
+			, m_writerCaller(nullptr)
+			, m_writeDepth(0)
+		{
+
+		}
+
+		// Access is tracked per object, moved object starts without any.
+		CLASS_CTOR			AccessTracker(	AccessTracker&&		other) noexcept
+			: AccessTracker()
+		{
+
+		}
+
+		AccessTracker&		operator=(		AccessTracker&&		other) noexcept
+		{
+			return *this;
+		}
+
+	public: // functions
+		void				begin_read(		const char*			LABEL) const
+		{
+			m_numReaders.fetch_add(1, std::memory_order_seq_cst);
+			if(is_written_by_other())
+			{
+				m_numReaders.fetch_sub(1, std::memory_order_release);
+				throw_conflict("read", LABEL, "writes", m_writerLabel, m_writerCaller);
+			}
+			m_readerLabel.store(LABEL, std::memory_order_relaxed);
+			m_readerCaller.store(AccessCaller::current(), std::memory_order_relaxed);
+		}
+
+		void				end_read() const
+		{
+			m_numReaders.fetch_sub(1, std::memory_order_release);
+		}
+
+		void				begin_write(	const char*			LABEL)
+		{
+			const std::thread::id THIS_THREAD = std::this_thread::get_id();
+			if(m_writer.load(std::memory_order_relaxed) == THIS_THREAD)
+			{
+				++m_writeDepth;
+				return;
+			}
+
+			std::thread::id noWriter;
+			if(!m_writer.compare_exchange_strong(noWriter, THIS_THREAD, std::memory_order_seq_cst))
+				throw_conflict("write", LABEL, "writes", m_writerLabel, m_writerCaller);
+
+			if(m_numReaders.load(std::memory_order_seq_cst) > 0)
+			{
+				m_writer.store(std::thread::id(), std::memory_order_release);
+				throw_conflict("write", LABEL, "reads", m_readerLabel, m_readerCaller);
+			}
+
+			m_writerLabel.store(LABEL, std::memory_order_relaxed);
+			m_writerCaller.store(AccessCaller::current(), std::memory_order_relaxed);
+			m_writeDepth = 1;
+		}
+
+		void				end_write()
+		{
+			if(--m_writeDepth > 0)
+				return;
+
+			m_writerLabel.store(nullptr, std::memory_order_relaxed);
+			m_writerCaller.store(nullptr, std::memory_order_relaxed);
+			m_writer.store(std::thread::id(), std::memory_order_release);
+		}
+
+		// Part may be read while other parts are modified, but not while the owner is written by another thread.
+		void				check_read_part(const char*			LABEL) const
+		{
+			if(is_written_by_other())
+				throw_conflict("read part", LABEL, "writes", m_writerLabel, m_writerCaller);
+		}
+
+		// Parts may be modified in parallel, but not while the owner is read or written by another thread.
+		void				check_write_part(const char*		LABEL) const
+		{
+			if(m_writer.load(std::memory_order_seq_cst) == std::this_thread::get_id())
+				return;
+
+			if(is_written_by_other())
+				throw_conflict("write part", LABEL, "writes", m_writerLabel, m_writerCaller);
+
+			if(m_numReaders.load(std::memory_order_seq_cst) > 0)
+				throw_conflict("write part", LABEL, "reads", m_readerLabel, m_readerCaller);
+		}
+
+	private: // functions
+		bool				is_written_by_other() const
+		{
+			const std::thread::id WRITER = m_writer.load(std::memory_order_seq_cst);
+			return WRITER != std::thread::id() && WRITER != std::this_thread::get_id();
+		}
+
+		static std::string	describe(		const char*			LABEL,
+											const char*			CALLER)
+		{
+			return std::string("[") + (CALLER? std::string(CALLER) + ": " : "") + (LABEL? LABEL : "unknown") + "]";
+		}
+
+		void				throw_conflict(	const char*								ACCESS,
+											const char*								LABEL,
+											const char*								OTHER_ACCESS,
+											const std::atomic<const char*>&			OTHER_LABEL,
+											const std::atomic<const char*>&			OTHER_CALLER) const
+		{
+			throw dpl::GeneralException(this, __LINE__, "Conflicting access: " + describe(LABEL, AccessCaller::current()) + " tried to " + ACCESS 
+														+ " while " + describe(OTHER_LABEL.load(std::memory_order_relaxed), OTHER_CALLER.load(std::memory_order_relaxed)) + " " + OTHER_ACCESS + ".");
+		}
+	};
+
+
+	/*
+		Trackers of the individual parts of the owner(e.g. columns of the component row).
+		Owner resizes them with its parts.
+	*/
+	class	AccessTrackers
+	{
+	private: // data
+		std::vector<AccessTracker> m_trackers;
+
+	public: // functions
+		void				resize(			const uint32_t		NUM_PARTS)
+		{
+			m_trackers.resize(NUM_PARTS);
+		}
+
+		AccessTracker&		operator[](		const uint32_t		INDEX)
+		{
+			return m_trackers[INDEX];
+		}
+
+		const AccessTracker&operator[](		const uint32_t		INDEX) const
+		{
+			return m_trackers[INDEX];
+		}
+	};
+#else
+	// Release builds do not track access.
+	class	AccessTracker
+	{
+	public: // functions
+		void				begin_read(		const char*			LABEL) const {}
+		void				end_read() const {}
+		void				begin_write(	const char*			LABEL) {}
+		void				end_write() {}
+		void				check_read_part(const char*			LABEL) const {}
+		void				check_write_part(const char*		LABEL) const {}
+	};
+
+	// Every part refers to the same empty tracker.
+	class	AccessTrackers : private AccessTracker
+	{
+	public: // functions
+		void				resize(			const uint32_t		NUM_PARTS) {}
+		AccessTracker&		operator[](		const uint32_t		INDEX) { return *this; }
+		const AccessTracker&operator[](		const uint32_t		INDEX) const { return *this; }
+	};
+#endif // _DEBUG
+
+
+	/*
+		Declares read access to the owner of the tracker for the lifetime of this object.
+	*/
+	class	ScopedRead
+	{
+#ifdef _DEBUG
+	private: // data
+		const AccessTracker& m_tracker;
+#endif // _DEBUG
+
+	public: // lifecycle
+		CLASS_CTOR			ScopedRead(		const AccessTracker&	TRACKER,
+											const char*				LABEL = nullptr)
+#ifdef _DEBUG
+			: m_tracker(TRACKER)
+		{
+			m_tracker.begin_read(LABEL);
+		}
+
+		CLASS_DTOR			~ScopedRead()
+		{
+			m_tracker.end_read();
+		}
+#else
+		{
+
+		}
+#endif // _DEBUG
+
+		CLASS_CTOR			ScopedRead(		const ScopedRead&		OTHER) = delete;
+		ScopedRead&			operator=(		const ScopedRead&		OTHER) = delete;
+	};
+
+
+	/*
+		Declares write access to the owner of the tracker for the lifetime of this object.
+	*/
+	class	ScopedWrite
+	{
+#ifdef _DEBUG
+	private: // data
+		AccessTracker& m_tracker;
+#endif // _DEBUG
+
+	public: // lifecycle
+		CLASS_CTOR			ScopedWrite(	AccessTracker&			tracker,
+											const char*				LABEL = nullptr)
+#ifdef _DEBUG
+			: m_tracker(tracker)
+		{
+			m_tracker.begin_write(LABEL);
+		}
+
+		CLASS_DTOR			~ScopedWrite()
+		{
+			m_tracker.end_write();
+		}
+#else
+		{
+
+		}
+#endif // _DEBUG
+
+		CLASS_CTOR			ScopedWrite(	const ScopedWrite&		OTHER) = delete;
+		ScopedWrite&		operator=(		const ScopedWrite&		OTHER) = delete;
+	};
+}
@@ -5,6 +5,7 @@
 #include "dpl_SystemManager.h"
 #include "dpl_TimeManager.h"
 #include "dpl_StateManager.h"
+#include "dpl_Task.h"
 
 
 // exit state
@@ -113,6 +114,9 @@ namespace dpl
 		dpl::ReadOnly<dpl::Mask32<Flags>,	Application>	flags;
 		dpl::ReadOnly<std::string,			Application>	name;
 
+	private:	// [DATA]
+		dpl::ResumeQueue									m_nextCycle; //<-- Coroutines resumed on the main thread at the beginning of the next cycle.
+
 	public:		// [SINGLETON FIX]
 		using	SingletonBase::ref;
 		using	SingletonBase::ptr;
@@ -133,6 +137,11 @@ namespace dpl
 		}
 
 	public:		// [FUNCTIONS]
+		ResumeQueue&		get_nextCycleQueue()
+		{
+			return m_nextCycle;
+		}
+
 		/*
 			Starts application.
 			Returns after shutdown or on terminate.
@@ -177,6 +186,7 @@ namespace dpl
 			if(!flags().at(WORKING)) return false;
 			if(flags().at(SHUTDOWN)) return false;
 			TimeManager::update();
+			EntityManager::reserve_for_next_frame();
 			return true;
 		}
 
@@ -186,6 +196,7 @@ namespace dpl
 			{
 				try
 				{
+					m_nextCycle.resume_all();
 					update_states(dpl::Logger::ref());
 					update_all_systems();
 				}
@@ -241,4 +252,13 @@ namespace dpl
 			flags->clear();
 		}
 	};
+
+
+	/*
+		co_await next_cycle() continues the coroutine on the main thread at the beginning of the next Application cycle.
+	*/
+	inline auto				next_cycle()
+	{
+		return resume_on(Application::ref().get_nextCycleQueue());
+	}
 }
\ No newline at end of file
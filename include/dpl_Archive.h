@@ -4,7 +4,6 @@
 #include "dpl_Association.h"
 #include "dpl_ReadOnly.h"
 #include <unordered_set>
-#include <xhash>
 #include <functional>
 
 
@@ -214,6 +213,16 @@ namespace dpl
 			return static_cast<uint32_t>(entries().size());
 		}
 
+		float					get_loadFactor() const
+		{
+			return entries().load_factor();
+		}
+
+		uint32_t				get_numBuckets() const
+		{
+			return static_cast<uint32_t>(entries().bucket_count());
+		}
+
 		/*
 			Returns true if entry was successfully added to the archive, or it was already a part of it.
 		*/
@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include <functional>
 #include <memory>
+#include <limits>
 #include "dpl_ReadOnly.h"
 #include "dpl_GeneralException.h"
 
@@ -2,4 +2,10 @@
 
 
 #define CLASS_CTOR // Helps to visually distinguish constructor from other functions.
-#define CLASS_DTOR // Helps to visually distinguish destructor from other functions.
\ No newline at end of file
+#define CLASS_DTOR // Helps to visually distinguish destructor from other functions.
+
+#ifdef _MSC_VER
+#define NO_UNIQUE_ADDRESS [[msvc::no_unique_address]] // MSVC ignores the standard attribute.
+#else
+#define NO_UNIQUE_ADDRESS [[no_unique_address]] // Empty member takes no space.
+#endif
\ No newline at end of file
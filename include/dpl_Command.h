@@ -11,8 +11,10 @@
 #include "dpl_TypeTraits.h"
 #include "dpl_Logger.h"
 
+#ifdef _MSC_VER
 #pragma warning( push )
 #pragma warning( disable : 26451)
+#endif
 
 // forward declarations
 namespace dpl
@@ -34,7 +36,7 @@ namespace dpl
 	private:	// [DATA]
 		dpl::ReadOnly<std::stringstream, BinaryState> stream;
 
-	private:	// [LIFECYCLE]
+	public:		// [LIFECYCLE]
 		CLASS_CTOR		BinaryState() = default;
 
 	public:		// [FUNCTIONS]
@@ -736,4 +738,6 @@ namespace dpl
 }
 */
 
-#pragma warning( pop )
\ No newline at end of file
+#ifdef _MSC_VER
+#pragma warning( pop )
+#endif
\ No newline at end of file
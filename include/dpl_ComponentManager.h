@@ -1,11 +1,16 @@
 #pragma once
 
 
+#include <bit>
+#include <array>
 #include "dpl_TypeTraits.h"
+#include "dpl_Mask.h"
 #include "dpl_Stream.h"
 #include "dpl_Singleton.h"
 #include "dpl_Variation.h"
 #include "dpl_ThreadPool.h"
+#include "dpl_AccessTracker.h"
+#include "dpl_SharedPages.h"
 
 
 // concepts
@@ -25,10 +30,46 @@ namespace dpl
 		static const bool value = is_Component<ComponentT>;
 	};
 
+	// Tags are empty types listed separately from components, they are not stored, only their presence is marked with a bit.
+	template<typename ComponentT>
+	concept is_TagComponent			=  is_Component<ComponentT>
+									&& std::is_empty_v<ComponentT>;
+
+	template<typename ComponentT>
+	struct	IsTagComponent
+	{
+		static const bool value = is_TagComponent<ComponentT>;
+	};
+
+	// Specialize as derived from std::true_type to store the component only for entities that were given one (see@ SparseTable).
+	template<typename ComponentT>
+	struct	SparseStorage_of : public std::false_type {};
+
+	template<typename ComponentT>
+	concept is_SparseComponent		=  is_Component<ComponentT>
+									&& SparseStorage_of<ComponentT>::value;
+
+	template<typename ComponentT>
+	struct	IsSparseComponent
+	{
+		static const bool value = is_SparseComponent<ComponentT>;
+	};
+
+	template<typename ComponentT>
+	struct	IsDataComponent
+	{
+		static const bool value = is_Component<ComponentT> && !is_SparseComponent<ComponentT>;
+	};
+
 	template<typename COMPONENT_TYPES>
 	concept	is_ComponentTypeList	=  dpl::is_TypeList<COMPONENT_TYPES> 
 									&& COMPONENT_TYPES::ALL_UNIQUE 
 									&& COMPONENT_TYPES::template all<IsComponent>();
+
+	template<typename TAG_TYPES>
+	concept	is_TagTypeList			=  dpl::is_TypeList<TAG_TYPES> 
+									&& TAG_TYPES::ALL_UNIQUE 
+									&& TAG_TYPES::template all<IsTagComponent>();
 }
 
 // queries
@@ -58,6 +99,12 @@ namespace dpl
 	template<typename CompositeT, is_ComponentTypeList COMPONENT_TYPES>
 	class	ComponentTable;
 
+	template<typename CompositeT, is_TagTypeList TAG_TYPES>
+	class	TagTable;
+
+	template<typename CompositeT, is_ComponentTypeList SPARSE_TYPES>
+	class	SparseTable;
+
 	class	ComponentStream;
 
 	template<is_StreamableComponent T>
@@ -88,6 +135,7 @@ namespace dpl
 		{
 		private:	// [SUBTYPES]
 			using	MyStorageBase	= ColumnStorage<T>;
+			using	MyPages			= dpl::CopyOnWritePages<T>;
 
 		public:		// [SUBTYPES]
 			using	Invoke		= typename ColumnStorage<T>::Invoke;
@@ -100,9 +148,10 @@ namespace dpl
 			friend	MyStorageBase;
 			friend	ComponentTable;
 
-		public:		// [EXPOSED FUNCTIONS]
-			using	MyStorageBase::size;
-			using	MyStorageBase::index_of;
+		private:	// [DATA]
+			std::unique_ptr<MyPages>			m_pages;	//<-- Elements shared with the fork, storage is empty until the row is resized (see@ fork_to).
+			NO_UNIQUE_ADDRESS AccessTracker m_access;	//<-- Empty in release builds.
+			NO_UNIQUE_ADDRESS AccessTrackers	m_columnAccess;	//<-- Checked by the access to a single component.
 
 		public:		// [LIFECYCLE]
 			CLASS_CTOR			Row() = default;
@@ -114,6 +163,16 @@ namespace dpl
 			Row&				operator=(			const Row&				OTHER) = delete;
 
 		public:		// [FUNCTIONS]
+			uint32_t			size() const
+			{
+				return m_pages? m_pages->size() : MyStorageBase::size();
+			}
+
+			uint32_t			capacity() const
+			{
+				return (m_pages && !m_pages->is_detached())? m_pages->capacity() : MyStorageBase::capacity();
+			}
+
 			uint32_t			offset() const
 			{
 				if constexpr(IS_STREAMABLE)	return MyStorageBase::offset;
@@ -122,52 +181,242 @@ namespace dpl
 
 			T*					modify()
 			{
-				if constexpr(IS_STREAMABLE)	return MyStorageBase::modify();
-				else							return MyStorageBase::data();
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::modify");
+				return modify_unchecked();
 			}
 
 			const T*			read() const
 			{
-				if constexpr(IS_STREAMABLE)	return MyStorageBase::read();
-				else							return MyStorageBase::data();
+				const ScopedRead ACCESS(m_access, "ComponentTable::Row::read");
+				return read_unchecked();
 			}
 
 			void				modify_each(		const Invoke&		INVOKE)
 			{
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::modify_each");
+				if(T* const COPIED = copy_shared())
+				{
+					for(uint32_t index = 0; index < size(); ++index) INVOKE(COPIED[index]);
+					return;
+				}
+
 				if constexpr(IS_STREAMABLE)	return MyStorageBase::modify_each(INVOKE);
 				else							return MyStorageBase::for_each(INVOKE);
 			}
 
+			// Shared pages are read in place (see@ fork_to).
 			void				read_each(			const InvokeConst&	INVOKE) const
 			{
+				const ScopedRead ACCESS(m_access, "ComponentTable::Row::read_each");
+				if(is_shared())
+				{
+					m_pages->for_each_page([&](const T* FIRST, const uint32_t NUM_ELEMENTS)
+					{
+						for(uint32_t index = 0; index < NUM_ELEMENTS; ++index) INVOKE(FIRST[index]);
+					});
+					return;
+				}
+
 				if constexpr(IS_STREAMABLE)	return MyStorageBase::read_each(INVOKE);
 				else							return MyStorageBase::for_each(INVOKE);
 			}
 
+			/*
+				Copies only the page of the shared component (see@ fork_to).
+				Components of different columns can be modified in parallel, the access is checked against the scopes of the row and of the column.
+			*/
 			T*					at(					const uint32_t			COLUMN_INDEX)
 			{
-				return modify() + COLUMN_INDEX;
+#ifdef _DEBUG
+				m_access.check_write_part("ComponentTable::Row::at");
+				const ScopedWrite COLUMN_ACCESS(m_columnAccess[COLUMN_INDEX], "ComponentTable::Row::at");
+#endif // _DEBUG
+				if(is_shared())
+				{
+					if(T* copied = m_pages->at(COLUMN_INDEX)) return copied;
+				}
+				return modify_unchecked() + COLUMN_INDEX;
 			}
 
+			/*
+				Shared component is read in place, without copying its page.
+				Warning! Returned address refers to the shared component until the component is modified in this row.
+			*/
 			const T*			at(					const uint32_t			COLUMN_INDEX) const
 			{
-				return read() + COLUMN_INDEX;
+#ifdef _DEBUG
+				m_access.check_read_part("ComponentTable::Row::at");
+				const ScopedRead COLUMN_ACCESS(m_columnAccess[COLUMN_INDEX], "ComponentTable::Row::at");
+#endif // _DEBUG
+				if(is_shared())
+				{
+					if(const T* FOUND = m_pages->find(COLUMN_INDEX)) return FOUND;
+				}
+				return read_unchecked() + COLUMN_INDEX;
+			}
+
+			// Returns pages shared with the fork, or nullptr if the components are stored by the row (see@ fork_to).
+			MyPages*			shared_pages()
+			{
+				return is_shared()? m_pages.get() : nullptr;
 			}
 
 			uint32_t			index_of(			const T*				COMPONENT_ADDRESS) const
 			{
+				if(m_pages) return m_pages->index_of(COMPONENT_ADDRESS, [&](){ return MyStorageBase::index_of(COMPONENT_ADDRESS); });
 				return MyStorageBase::index_of(COMPONENT_ADDRESS);
 			}
 
+			/*
+				Shares components with the CLONE row of the same size (its current components are destroyed).
+				Page of the components is copied by the row that modifies it first, any other row keeps sharing it.
+				Shared pages are detached only when the row is resized or forked again.
+				Rows attached to the stream are copied at once.
+			*/
+			void				fork_to(			Row&					clone)
+			{
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::fork_to");
+				const ScopedWrite CLONE_ACCESS(clone.m_access, "ComponentTable::Row::fork_to");
+				if(size() == 0) return;
+
+				if constexpr(IS_STREAMABLE)
+				{
+					if(MyStorageBase::is_stream_ready())
+					{
+						std::copy_n(read(), size(), clone.modify());
+						return;
+					}
+				}
+
+				if(!m_pages || !m_pages->can_share())
+				{
+					const uint32_t SIZE = size();
+					release_pages();
+					m_pages = std::make_unique<MyPages>(MyStorageBase::release_buffer(), SIZE);
+				}
+
+				clone.release_pages();
+				if constexpr(IS_STREAMABLE)	clone.MyStorageBase::destroy_all_elements();
+				else							clone.MyStorageBase::clear();
+				clone.m_pages = m_pages->share();
+			}
+
+		public:		// [ACCESS] (checked in debug builds only)
+			ScopedRead			scoped_read(		const char*				LABEL = nullptr) const
+			{
+				return ScopedRead(m_access, LABEL);
+			}
+
+			ScopedWrite			scoped_write(		const char*				LABEL = nullptr)
+			{
+				return ScopedWrite(m_access, LABEL);
+			}
+
+			// Declares access to a single component, that is held longer than the call to at.
+			ScopedRead			scoped_read_at(		const uint32_t			COLUMN_INDEX,
+													const char*				LABEL = nullptr) const
+			{
+				return ScopedRead(m_columnAccess[COLUMN_INDEX], LABEL);
+			}
+
+			ScopedWrite			scoped_write_at(	const uint32_t			COLUMN_INDEX,
+													const char*				LABEL = nullptr)
+			{
+				return ScopedWrite(m_columnAccess[COLUMN_INDEX], LABEL);
+			}
+
 		private:	// [INTERNAL FUNCTIONS]
+			// Shared row is not reserved, its storage is replaced by the detached pages on the next resize.
+			void				reserve(			const uint32_t			NUM_COLUMNS)
+			{
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::reserve");
+				if(is_shared() || NUM_COLUMNS <= MyStorageBase::capacity()) return;
+				MyStorageBase::reserve(NUM_COLUMNS);
+			}
+
 			T*					enlarge(			const uint32_t			NUM_COLUMNS)
 			{
-				return MyStorageBase::enlarge(NUM_COLUMNS);
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::enlarge");
+				release_pages();
+				T* const FIRST = MyStorageBase::enlarge(NUM_COLUMNS);
+				m_columnAccess.resize(size());
+				return FIRST;
 			}
 
 			void				destroy_at(			const uint32_t			COLUMN_INDEX)
 			{
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::destroy_at");
+				release_pages();
 				MyStorageBase::fast_erase(COLUMN_INDEX);
+				m_columnAccess.resize(size());
+			}
+
+			void				move_at(			const uint32_t			SOURCE_INDEX,
+													const uint32_t			TARGET_INDEX)
+			{
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::move_at");
+				*at(TARGET_INDEX) = std::move(*at(SOURCE_INDEX));
+			}
+
+			void				swap_at(			const uint32_t			FIRST_INDEX,
+													const uint32_t			SECOND_INDEX)
+			{
+				const ScopedWrite ACCESS(m_access, "ComponentTable::Row::swap_at");
+				std::swap(*at(FIRST_INDEX), *at(SECOND_INDEX));
+			}
+
+			T*					modify_unchecked()
+			{
+				if(T* const COPIED = copy_shared()) return COPIED;
+				if constexpr(IS_STREAMABLE)	return MyStorageBase::modify();
+				else							return MyStorageBase::data();
+			}
+
+			const T*			read_unchecked() const
+			{
+				if(is_shared())
+				{
+					if(const T* ALL = m_pages->read_all()) return ALL;
+				}
+				if constexpr(IS_STREAMABLE)	return MyStorageBase::read();
+				else							return MyStorageBase::data();
+			}
+
+			bool				is_shared() const
+			{
+				return m_pages && !m_pages->is_detached();
+			}
+
+			/*
+				Copies every shared page, the row keeps the pages until it is resized.
+				Row attached to the stream detaches them instead, so that the stream is notified about the modification.
+				Returns nullptr if nothing is shared.
+			*/
+			T*					copy_shared()
+			{
+				if(!is_shared()) return nullptr;
+				if constexpr(IS_STREAMABLE)
+				{
+					if(MyStorageBase::is_stream_ready())
+					{
+						release_pages();
+						return nullptr;
+					}
+				}
+				return m_pages->copy_all();
+			}
+
+			// Moves shared components to the storage, requires exclusive access.
+			void				release_pages()
+			{
+				if(is_shared())
+				{
+					m_pages->detach([&](dpl::Buffer<T>&& buffer, const uint32_t SIZE)
+					{
+						MyStorageBase::adopt(std::move(buffer), SIZE);
+					});
+				}
+				m_pages.reset();
 			}
 		};
 
@@ -201,7 +450,7 @@ namespace dpl
 		uint32_t					numColumns() const
 		{
 			using FirstComponentType = COMPONENT_TYPES::template At<0>;
-			return Row<FirstComponentType>::size();
+			return ComponentTable::row<FirstComponentType>().size();
 		}
 
 		Column						column(			const uint32_t		COLUMN_INDEX)
@@ -230,11 +479,421 @@ namespace dpl
 		{
 			return ComponentTable::add_columns(1);
 		}
+
+		void						reserve_columns(const uint32_t		NUM_COLUMNS)
+		{
+			(ComponentTable::row<ComponentTn>().reserve(NUM_COLUMNS), ...);
+		}
 			
 		void						remove_column(	const uint32_t		COLUMN_INDEX)
 		{
 			(ComponentTable::row<ComponentTn>().destroy_at(COLUMN_INDEX), ...);
 		}
+
+		// Overrides components in the target column with those from the source column.
+		void						move_column(	const uint32_t		SOURCE_INDEX,
+													const uint32_t		TARGET_INDEX)
+		{
+			(ComponentTable::row<ComponentTn>().move_at(SOURCE_INDEX, TARGET_INDEX), ...);
+		}
+
+		void						swap_columns(	const uint32_t		FIRST_INDEX,
+													const uint32_t		SECOND_INDEX)
+		{
+			(ComponentTable::row<ComponentTn>().swap_at(FIRST_INDEX, SECOND_INDEX), ...);
+		}
+
+		void						remove_last_columns(const uint32_t	NUM_COLUMNS)
+		{
+			for(uint32_t index = 0; index < NUM_COLUMNS; ++index)
+			{
+				ComponentTable::remove_column(numColumns()-1);
+			}
+		}
+	};
+
+
+	template<typename CompositeT, typename... TagTn>
+	class	TagTable<CompositeT, dpl::TypeList<TagTn...>>
+	{
+	public:		// [SUBTYPES]
+		using	TAG_TYPES	= dpl::TypeList<TagTn...>;
+		using	Word		= dpl::Mask64_t;
+
+		// Stores one bit per column (64 columns per word).
+		class	Row
+		{
+		public:		// [CONSTANTS]
+			static constexpr uint32_t NUM_WORD_BITS = Word::MAX_NUM_BITS;
+
+		public:		// [FRIENDS]
+			friend	TagTable;
+
+		private:	// [DATA]
+			std::vector<Word> m_words;
+
+		public:		// [FUNCTIONS]
+			uint32_t			numWords() const
+			{
+				return (uint32_t)m_words.size();
+			}
+
+			uint64_t			word(				const uint32_t			WORD_INDEX) const
+			{
+				return m_words[WORD_INDEX].get();
+			}
+
+			bool				at(					const uint32_t			COLUMN_INDEX) const
+			{
+				return m_words[COLUMN_INDEX / NUM_WORD_BITS].at(COLUMN_INDEX % NUM_WORD_BITS);
+			}
+
+			uint32_t			count() const
+			{
+				uint32_t numSetBits = 0;
+				for(const Word& WORD : m_words)
+				{
+					numSetBits += (uint32_t)std::popcount(WORD.get());
+				}
+				return numSetBits;
+			}
+
+		private:	// [INTERNAL FUNCTIONS]
+			void				set_at(				const uint32_t			COLUMN_INDEX,
+													const bool				bVALUE)
+			{
+				m_words[COLUMN_INDEX / NUM_WORD_BITS].set_at(COLUMN_INDEX % NUM_WORD_BITS, bVALUE);
+			}
+
+			// Bits of the new columns are always cleared (see@ remove_last_columns).
+			void				resize(				const uint32_t			NUM_COLUMNS)
+			{
+				m_words.resize((NUM_COLUMNS + NUM_WORD_BITS - 1) / NUM_WORD_BITS);
+			}
+
+			void				reserve(			const uint32_t			NUM_COLUMNS)
+			{
+				m_words.reserve((NUM_COLUMNS + NUM_WORD_BITS - 1) / NUM_WORD_BITS);
+			}
+		};
+
+		using	Rows		= std::array<Row, TAG_TYPES::SIZE>;
+
+	private:	// [DATA]
+		Rows		m_rows;
+		uint32_t	m_numColumns;
+
+	protected:	// [LIFECYCLE]
+		CLASS_CTOR					TagTable()
+			: m_numColumns(0)
+		{
+
+		}
+
+	public:		// [ROW FUNCTIONS]
+		template<dpl::is_one_of<TAG_TYPES> T>
+		const Row&					tag_row() const
+		{
+			return m_rows[TAG_TYPES::template index_of<T>()];
+		}
+
+		template<dpl::is_one_of<TAG_TYPES> T>
+		bool						has_tag_at(		const uint32_t		COLUMN_INDEX) const
+		{
+			return tag_row<T>().at(COLUMN_INDEX);
+		}
+
+		template<dpl::is_one_of<TAG_TYPES> T>
+		void						set_tag_at(		const uint32_t		COLUMN_INDEX,
+													const bool			bVALUE)
+		{
+			m_rows[TAG_TYPES::template index_of<T>()].set_at(COLUMN_INDEX, bVALUE);
+		}
+
+		/*
+			Invokes function with the index of each column in range [0, NUM_COLUMNS) that has all of the given tags.
+			Bits of the given rows are combined word by word, so 64 columns without the tags are skipped at once.
+			NOTE: Tags may be modified during iteration, but columns must not be added, removed, or swapped.
+		*/
+		template<dpl::is_one_of<TAG_TYPES>... Ts> requires (sizeof...(Ts) > 0)
+		void						for_each_tagged_column(	const uint32_t								NUM_COLUMNS,
+															const std::function<void(uint32_t)>&		INVOKE) const
+		{
+			const uint32_t NUM_WORDS		= (NUM_COLUMNS + Row::NUM_WORD_BITS - 1) / Row::NUM_WORD_BITS;
+			const uint32_t NUM_TAIL_BITS	= NUM_COLUMNS % Row::NUM_WORD_BITS;
+
+			for(uint32_t wordIndex = 0; wordIndex < NUM_WORDS; ++wordIndex)
+			{
+				uint64_t bits = (tag_row<Ts>().word(wordIndex) & ...);
+				if(NUM_TAIL_BITS > 0 && wordIndex == NUM_WORDS - 1) bits &= (uint64_t(1) << NUM_TAIL_BITS) - 1;
+
+				const uint32_t FIRST_COLUMN = wordIndex * Row::NUM_WORD_BITS;
+				while(bits)
+				{
+					INVOKE(FIRST_COLUMN + (uint32_t)std::countr_zero(bits));
+					bits &= bits - 1; //<-- Clear lowest set bit.
+				}
+			}
+		}
+
+	protected:	// [COLUMN FUNCTIONS]
+		void						add_tag_columns(	const uint32_t		NUM_COLUMNS)
+		{
+			m_numColumns += NUM_COLUMNS;
+			for(Row& row : m_rows) row.resize(m_numColumns);
+		}
+
+		void						reserve_tag_columns(const uint32_t		NUM_COLUMNS)
+		{
+			for(Row& row : m_rows) row.reserve(NUM_COLUMNS);
+		}
+
+		// Overrides tags in the target column with those from the source column.
+		void						move_tag_column(	const uint32_t		SOURCE_INDEX,
+														const uint32_t		TARGET_INDEX)
+		{
+			for(Row& row : m_rows) row.set_at(TARGET_INDEX, row.at(SOURCE_INDEX));
+		}
+
+		void						swap_tag_columns(	const uint32_t		FIRST_INDEX,
+														const uint32_t		SECOND_INDEX)
+		{
+			for(Row& row : m_rows)
+			{
+				const bool FIRST_VALUE = row.at(FIRST_INDEX);
+				row.set_at(FIRST_INDEX, row.at(SECOND_INDEX));
+				row.set_at(SECOND_INDEX, FIRST_VALUE);
+			}
+		}
+
+		void						remove_last_tag_columns(const uint32_t	NUM_COLUMNS)
+		{
+			for(Row& row : m_rows)
+			{
+				for(uint32_t index = m_numColumns - NUM_COLUMNS; index < m_numColumns; ++index)
+				{
+					row.set_at(index, false);
+				}
+			}
+
+			m_numColumns -= NUM_COLUMNS;
+			for(Row& row : m_rows) row.resize(m_numColumns);
+		}
+
+		void						copy_tag_columns(	const TagTable&		SOURCE)
+		{
+			m_rows			= SOURCE.m_rows;
+			m_numColumns	= SOURCE.m_numColumns;
+		}
+	};
+
+
+	/*
+		[DATA]:			Components stored only for some columns
+		[STORAGE]:		contiguous (dense array + sparse index per column)
+		[ORDER]:		undefined
+		[INSERTION]:	fast
+		[ERASURE]:		fast
+	*/
+	template<typename CompositeT, typename... SparseTn>
+	class	SparseTable<CompositeT, dpl::TypeList<SparseTn...>>
+	{
+	public:		// [SUBTYPES]
+		using	SPARSE_TYPES = dpl::TypeList<SparseTn...>;
+
+		template<is_SparseComponent T>
+		class	Row
+		{
+		public:		// [CONSTANTS]
+			static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+		public:		// [FRIENDS]
+			friend	SparseTable;
+
+		private:	// [DATA]
+			std::vector<T>			m_components;
+			std::vector<uint32_t>	m_owners;	//<-- Column index of each component.
+			std::vector<uint32_t>	m_indices;	//<-- Component index for each column (INVALID_INDEX if column has no component).
+
+		public:		// [FUNCTIONS]
+			// Returns number of stored components.
+			uint32_t			size() const
+			{
+				return (uint32_t)m_components.size();
+			}
+
+			bool				has(				const uint32_t			COLUMN_INDEX) const
+			{
+				return m_indices[COLUMN_INDEX] != INVALID_INDEX;
+			}
+
+			// Returns nullptr if column has no component.
+			T*					at(					const uint32_t			COLUMN_INDEX)
+			{
+				const uint32_t INDEX = m_indices[COLUMN_INDEX];
+				return (INDEX != INVALID_INDEX)? &m_components[INDEX] : nullptr;
+			}
+
+			const T*			at(					const uint32_t			COLUMN_INDEX) const
+			{
+				const uint32_t INDEX = m_indices[COLUMN_INDEX];
+				return (INDEX != INVALID_INDEX)? &m_components[INDEX] : nullptr;
+			}
+
+			T*					data()
+			{
+				return m_components.data();
+			}
+
+			const T*			data() const
+			{
+				return m_components.data();
+			}
+
+			const uint32_t*		owners() const
+			{
+				return m_owners.data();
+			}
+
+		private:	// [INTERNAL FUNCTIONS]
+			// Returns existing component if column already has one.
+			T&					add(				const uint32_t			COLUMN_INDEX)
+			{
+				uint32_t& index = m_indices[COLUMN_INDEX];
+				if(index == INVALID_INDEX)
+				{
+					index = size();
+					m_components.emplace_back();
+					m_owners.push_back(COLUMN_INDEX);
+				}
+				return m_components[index];
+			}
+
+			bool				remove(				const uint32_t			COLUMN_INDEX)
+			{
+				const uint32_t INDEX = m_indices[COLUMN_INDEX];
+				if(INDEX == INVALID_INDEX) return false;
+
+				const uint32_t LAST_INDEX = size()-1;
+				if(INDEX != LAST_INDEX)
+				{
+					m_components[INDEX]			= std::move(m_components[LAST_INDEX]);
+					m_owners[INDEX]				= m_owners[LAST_INDEX];
+					m_indices[m_owners[INDEX]]	= INDEX;
+				}
+
+				m_components.pop_back();
+				m_owners.pop_back();
+				m_indices[COLUMN_INDEX] = INVALID_INDEX;
+				return true;
+			}
+
+			void				add_columns(		const uint32_t			NUM_COLUMNS)
+			{
+				m_indices.resize(m_indices.size() + NUM_COLUMNS, INVALID_INDEX);
+			}
+
+			// Components are not reserved, number of owners is not known in advance.
+			void				reserve_columns(	const uint32_t			NUM_COLUMNS)
+			{
+				m_indices.reserve(NUM_COLUMNS);
+			}
+
+			// Component of the target column is replaced with the one from the source column.
+			void				move_column(		const uint32_t			SOURCE_INDEX,
+													const uint32_t			TARGET_INDEX)
+			{
+				Row::remove(TARGET_INDEX);
+				const uint32_t INDEX = m_indices[SOURCE_INDEX];
+				if(INDEX != INVALID_INDEX) m_owners[INDEX] = TARGET_INDEX;
+				m_indices[TARGET_INDEX] = INDEX;
+				m_indices[SOURCE_INDEX] = INVALID_INDEX;
+			}
+
+			void				swap_columns(		const uint32_t			FIRST_INDEX,
+													const uint32_t			SECOND_INDEX)
+			{
+				std::swap(m_indices[FIRST_INDEX], m_indices[SECOND_INDEX]);
+				if(m_indices[FIRST_INDEX] != INVALID_INDEX)		m_owners[m_indices[FIRST_INDEX]]	= FIRST_INDEX;
+				if(m_indices[SECOND_INDEX] != INVALID_INDEX)	m_owners[m_indices[SECOND_INDEX]]	= SECOND_INDEX;
+			}
+
+			void				remove_last_columns(const uint32_t			NUM_COLUMNS)
+			{
+				const uint32_t NEW_NUM_COLUMNS = (uint32_t)m_indices.size() - NUM_COLUMNS;
+				for(uint32_t index = NEW_NUM_COLUMNS; index < m_indices.size(); ++index)
+				{
+					Row::remove(index);
+				}
+				m_indices.resize(NEW_NUM_COLUMNS);
+			}
+		};
+
+		using	Rows		= std::tuple<Row<SparseTn>...>;
+
+	private:	// [DATA]
+		Rows m_rows; //<-- Each row has the same number of columns, but different number of components.
+
+	protected:	// [LIFECYCLE]
+		CLASS_CTOR					SparseTable() = default;
+
+	public:		// [ROW FUNCTIONS]
+		template<dpl::is_one_of<SPARSE_TYPES> T>
+		const Row<T>&				sparse_row() const
+		{
+			return std::get<Row<T>>(m_rows);
+		}
+
+		template<dpl::is_one_of<SPARSE_TYPES> T>
+		Row<T>&						sparse_row()
+		{
+			return std::get<Row<T>>(m_rows);
+		}
+
+		template<dpl::is_one_of<SPARSE_TYPES> T>
+		T&							add_sparse_at(		const uint32_t		COLUMN_INDEX)
+		{
+			return sparse_row<T>().add(COLUMN_INDEX);
+		}
+
+		template<dpl::is_one_of<SPARSE_TYPES> T>
+		bool						remove_sparse_at(	const uint32_t		COLUMN_INDEX)
+		{
+			return sparse_row<T>().remove(COLUMN_INDEX);
+		}
+
+	protected:	// [COLUMN FUNCTIONS]
+		void						add_sparse_columns(	const uint32_t		NUM_COLUMNS)
+		{
+			(SparseTable::sparse_row<SparseTn>().add_columns(NUM_COLUMNS), ...);
+		}
+
+		void						reserve_sparse_columns(const uint32_t	NUM_COLUMNS)
+		{
+			(SparseTable::sparse_row<SparseTn>().reserve_columns(NUM_COLUMNS), ...);
+		}
+
+		void						move_sparse_column(	const uint32_t		SOURCE_INDEX,
+														const uint32_t		TARGET_INDEX)
+		{
+			(SparseTable::sparse_row<SparseTn>().move_column(SOURCE_INDEX, TARGET_INDEX), ...);
+		}
+
+		void						swap_sparse_columns(const uint32_t		FIRST_INDEX,
+														const uint32_t		SECOND_INDEX)
+		{
+			(SparseTable::sparse_row<SparseTn>().swap_columns(FIRST_INDEX, SECOND_INDEX), ...);
+		}
+
+		void						remove_last_sparse_columns(const uint32_t	NUM_COLUMNS)
+		{
+			(SparseTable::sparse_row<SparseTn>().remove_last_columns(NUM_COLUMNS), ...);
+		}
+
+		void						copy_sparse_columns(const SparseTable&	SOURCE)
+		{
+			m_rows = SOURCE.m_rows;
+		}
 	};
 
 
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <memory>
+#include <cstring>
 #include "dpl_Buffer.h"
 #include "dpl_ReadOnly.h"
 
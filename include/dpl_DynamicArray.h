@@ -330,6 +330,29 @@ namespace dpl
 			relocate(INITIAL_CAPACITY);
 		}
 
+		/*
+			Moves out the buffer with all the elements, the array is left empty.
+			WARNING! Elements of the released buffer are not destroyed by the buffer itself.
+		*/
+		dpl::Buffer<T>			release_buffer()
+		{
+			dpl::Buffer<T> released(INITIAL_CAPACITY);
+			released.swap(m_buffer);
+			m_size = 0;
+			return released;
+		}
+
+		/*
+			Takes ownership of the BUFFER with SIZE constructed elements (current elements are destroyed).
+		*/
+		void					adopt(							dpl::Buffer<T>&&			buffer,
+																const uint32_t				SIZE)
+		{
+			clear_internal();
+			m_buffer	= std::move(buffer);
+			m_size		= SIZE;
+		}
+
 		void					import_from(					std::istream&				binary)
 		{
 			clear_internal();
@@ -2,6 +2,9 @@
 
 
 #include <algorithm>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
 #include "dpl_NamedType.h"
 #include "dpl_Membership.h"
 #include "dpl_Labelable.h"
@@ -9,6 +12,7 @@
 #include "dpl_std_addons.h"
 #include "dpl_Logger.h"
 #include "dpl_ComponentManager.h"
+#include "dpl_Parallel.h"
 
 
 #include "dpl_Command.h"
@@ -22,7 +26,6 @@
 	- custom factory pattern for EntityManager and EntityPack
 	- parent-child relation should not be possible if parent type is derived from one of the types that are already on the child's list of parents
 	- parent-child relation should not be possible if child type is derived from one of the types that are already on the parent's list of children
-	- Relation should accept any uint32_t except 0 as first argument which should be interpreted as max number of children.
 */
 
 
@@ -55,21 +58,34 @@ namespace dpl
 	enum	RelationType : uint32_t
 	{
 		ONE_TO_ONE = 1, // A parent can only have one child of the given type.
-		// ONE_TO_SPECIFIC_NUMBER // Allows specific number of children. (TODO)
 		ONE_TO_MANY = std::numeric_limits<uint32_t>::max() // A parent can have many children of the given type.
 	};
 
+	// A parent can have up to MAX_CHILDREN children of the given type (stored inline in the parent).
+	template<uint32_t MAX_CHILDREN>
+	constexpr RelationType ONE_TO_SPECIFIC_NUMBER = static_cast<RelationType>(MAX_CHILDREN);
+
 	enum	Dependency
 	{
 		WEAK_DEPENDENCY,	// Child will not be destroyed along with the parent on EntityManager::cmd_destroy_hierarchy.
 		STRONG_DEPENDENCY	// Child will be destroyed along with the parent on EntityManager::cmd_destroy_hierarchy.
 	};
 
-	template<RelationType USER_TYPE, Dependency USER_DEPENDENCY>
+	enum	RelationStorage
+	{
+		LINKED_STORAGE,		// Children are stored as an intrusive linked list (cheap to modify, slow to traverse).
+		CONTIGUOUS_STORAGE	// Parent stores a dense array of pointers to its children (random access, prefetchable iteration). Always used by ONE_TO_SPECIFIC_NUMBER.
+	};
+
+	template<RelationType USER_TYPE, Dependency USER_DEPENDENCY, RelationStorage USER_STORAGE = LINKED_STORAGE>
 	struct	Relation
 	{
-		static const RelationType	TYPE		= USER_TYPE;
-		static const Dependency		DEPENDENCY	= USER_DEPENDENCY;
+		static_assert(USER_TYPE != 0, "Relation must allow at least one child.");
+		static_assert(USER_STORAGE == LINKED_STORAGE || USER_TYPE != ONE_TO_ONE, "Contiguous storage is not available for the ONE_TO_ONE relation.");
+
+		static const RelationType		TYPE		= USER_TYPE;
+		static const Dependency			DEPENDENCY	= USER_DEPENDENCY;
+		static const RelationStorage	STORAGE		= USER_STORAGE;
 	};
 
 	template<typename ParentT, typename ChildT>
@@ -95,6 +111,22 @@ namespace dpl
 
 	template<typename EntityT>
 	using	ComponentList_of	= typename Description_of<EntityT>::ComponentTypes;
+
+	// TagTypes are optional in the description.
+	template<typename EntityT>
+	struct	TagListQuery
+	{
+		using Type = dpl::TypeList<>;
+	};
+
+	template<typename EntityT> requires requires { typename Description_of<EntityT>::TagTypes; }
+	struct	TagListQuery<EntityT>
+	{
+		using Type = typename Description_of<EntityT>::TagTypes;
+	};
+
+	template<typename EntityT>
+	using	TagList_of			= typename TagListQuery<EntityT>::Type;
 }
 
 // common concepts			(internal)
@@ -140,7 +172,7 @@ namespace dpl
 	template<typename EntityT>
 	struct	RootBaseQuery
 	{
-	private:	using Base	= std::conditional_t<has_Base<EntityT>, typename Base_of<EntityT>, void>;
+	private:	using Base	= std::conditional_t<has_Base<EntityT>, Base_of<EntityT>, void>;
 	public:		using Type	= std::conditional_t<has_Base<Base>, typename RootBaseQuery<Base>::Type, EntityT>;
 	};
 
@@ -155,8 +187,8 @@ namespace dpl
 	template<typename EntityT>
 	struct	ParentQuery
 	{
-		using Base					= std::conditional_t<has_Base<EntityT>, typename Base_of<EntityT>, void>;
-		using OwnParentTypes		= typename ParentList_of<EntityT>;
+		using Base					= std::conditional_t<has_Base<EntityT>, Base_of<EntityT>, void>;
+		using OwnParentTypes		= ParentList_of<EntityT>;
 		using InheritedParentTypes	= typename ParentQuery<Base>::AllParentTypes;
 
 		using AllParentTypes		= dpl::merge_t<	OwnParentTypes, 
@@ -174,8 +206,8 @@ namespace dpl
 	template<typename EntityT>
 	struct	ChildQuery
 	{
-		using Base					= std::conditional_t<has_Base<EntityT>, typename Base_of<EntityT>, void>;
-		using OwnChildTypes			= typename ChildList_of<EntityT>;
+		using Base					= std::conditional_t<has_Base<EntityT>, Base_of<EntityT>, void>;
+		using OwnChildTypes			= ChildList_of<EntityT>;
 		using InheritedChildTypes	= typename ChildQuery<Base>::AllChildTypes;
 
 		using AllChildTypes			= dpl::merge_t<	OwnChildTypes, 
@@ -193,8 +225,8 @@ namespace dpl
 	template<typename EntityT>
 	struct	PartnerQuery
 	{
-		using Base					= std::conditional_t<has_Base<EntityT>, typename Base_of<EntityT>, void>;
-		using OwnPartnerTypes		= typename PartnerList_of<EntityT>;
+		using Base					= std::conditional_t<has_Base<EntityT>, Base_of<EntityT>, void>;
+		using OwnPartnerTypes		= PartnerList_of<EntityT>;
 		using InheritedPartnerTypes	= typename PartnerQuery<Base>::AllPartnerTypes;
 
 		using AllPartnerTypes		= dpl::merge_t<	OwnPartnerTypes, 
@@ -212,8 +244,8 @@ namespace dpl
 	template<typename EntityT>
 	struct	ComponentQuery
 	{
-		using Base						= std::conditional_t<has_Base<EntityT>, typename Base_of<EntityT>, void>;
-		using OwnComponentTypes			= typename ComponentList_of<EntityT>;
+		using Base						= std::conditional_t<has_Base<EntityT>, Base_of<EntityT>, void>;
+		using OwnComponentTypes			= ComponentList_of<EntityT>;
 		using InheritedComponentTypes	= typename ComponentQuery<Base>::AllComponentTypes;
 
 		using AllComponentTypes			= dpl::merge_t<	OwnComponentTypes, 
@@ -225,6 +257,23 @@ namespace dpl
 	{
 		using AllComponentTypes = dpl::TypeList<>;
 	};
+
+	template<typename EntityT>
+	struct	TagQuery
+	{
+		using Base					= std::conditional_t<has_Base<EntityT>, Base_of<EntityT>, void>;
+		using OwnTagTypes			= TagList_of<EntityT>;
+		using InheritedTagTypes		= typename TagQuery<Base>::AllTagTypes;
+
+		using AllTagTypes			= dpl::merge_t<	OwnTagTypes, 
+													InheritedTagTypes>;
+	};
+
+	template<>
+	struct	TagQuery<void>
+	{
+		using AllTagTypes = dpl::TypeList<>;
+	};
 }
 
 // query results			(internal)
@@ -249,7 +298,13 @@ namespace dpl
 	using	AllPartnerTypes_of		= typename PartnerQuery<EntityT>::AllPartnerTypes;
 
 	template<typename EntityT>
-	using	AllComponentTypes_of	= typename ComponentQuery<EntityT>::AllComponentTypes;
+	using	AllComponentTypes_of	= typename ComponentQuery<EntityT>::AllComponentTypes::template Subtypes<IsDataComponent>;
+
+	template<typename EntityT>
+	using	AllTagTypes_of			= typename TagQuery<EntityT>::AllTagTypes;
+
+	template<typename EntityT>
+	using	AllSparseTypes_of		= typename ComponentQuery<EntityT>::AllComponentTypes::template Subtypes<IsSparseComponent>;
 
 
 	template<typename ParentT, typename ChildT>
@@ -369,7 +424,7 @@ namespace dpl
 		using	StorageID	= Origin::StorageID;
 
 	public:		// [CONSTANTS
-		static const StorageID INVALID_STORAGE_ID = dpl::Variant<EntityManager, EntityPack>::INVALID_INDEX;
+		static constexpr StorageID INVALID_STORAGE_ID = dpl::Variant<EntityManager, EntityPack>::INVALID_INDEX;
 
 	public:		// [FRIENDS]
 		template<typename>
@@ -454,6 +509,56 @@ namespace dpl
 	template<is_Entity T> using InvokeSimilarIndexedEntityBuffer	= std::function<void(dpl::EntityPackView<T>, uint32_t)>;
 }
 
+// entity remap				(internal)
+namespace dpl
+{
+	/*
+		Translates addresses of the entities (or their members) stored in one world to the addresses of their copies in another world.
+		Copy must be stored in the pack of the same type, at the same index as the original.
+	*/
+	class	EntityRemap
+	{
+	private:	// [SUBTYPES]
+		struct	Entry
+		{
+			const char*	sourceBegin;
+			const char*	sourceEnd;
+			char*		targetBegin;
+		};
+
+	private:	// [DATA]
+		std::vector<Entry> m_entries; //<-- Sorted by the first byte of the source.
+
+	public:		// [FUNCTIONS]
+		void		add(		const char*		SOURCE_BEGIN,
+								const char*		SOURCE_END,
+								char*			targetBegin)
+		{
+			auto it = std::upper_bound(m_entries.begin(), m_entries.end(), SOURCE_BEGIN, [](const char* BYTE, const Entry& ENTRY)
+			{
+				return BYTE < ENTRY.sourceBegin;
+			});
+			m_entries.insert(it, Entry{SOURCE_BEGIN, SOURCE_END, targetBegin});
+		}
+
+		// Returns nullptr if the source address does not belong to any pack.
+		template<typename T>
+		T*			operator()(	const T*		SOURCE) const
+		{
+			const char*	BYTE_PTR	= reinterpret_cast<const char*>(SOURCE);
+			auto		it			= std::upper_bound(m_entries.begin(), m_entries.end(), BYTE_PTR, [](const char* BYTE, const Entry& ENTRY)
+			{
+				return BYTE < ENTRY.sourceBegin;
+			});
+
+			if(it == m_entries.begin()) return nullptr;
+			--it;
+			if(BYTE_PTR >= it->sourceEnd) return nullptr;
+			return reinterpret_cast<T*>(it->targetBegin + (BYTE_PTR - it->sourceBegin));
+		}
+	};
+}
+
 // entity storage			<------------------------------ FOR THE USER
 namespace dpl
 {
@@ -468,15 +573,60 @@ namespace dpl
 		template<typename>
 		friend class EntityPack_of;
 
+	public:		// [SUBTYPES]
+		class	DestructionBatch;
+
+		// Memory and churn statistics of the pack (see@ EntityManager::collect_stats).
+		struct	Stats
+		{
+			std::string	typeName;
+			uint32_t	typeID					= 0;
+			uint32_t	numEntities				= 0;
+			uint32_t	numActive				= 0;
+			uint32_t	capacity				= 0;	//<-- Number of entities that fit in the storage without relocation.
+			uint64_t	entitySize				= 0;	//<-- sizeof(EntityT)
+			uint64_t	componentSize			= 0;	//<-- Bytes per entity in all dense component rows.
+			uint64_t	componentRowBytes		= 0;	//<-- Bytes reserved by all dense component rows (by their capacity).
+			uint32_t	numComponentRows		= 0;
+			uint32_t	numTagRows				= 0;
+			uint32_t	numSparseRows			= 0;
+			uint32_t	numSparseComponents		= 0;	//<-- Sparse components owned by entities of the pack (all types).
+			float		labelerLoadFactor		= 0.f;
+			uint32_t	labelerNumBuckets		= 0;
+			uint32_t	numParentTypes			= 0;
+			uint32_t	numChildTypes			= 0;
+			uint32_t	numPartnerTypes			= 0;
+			uint64_t	numChildren				= 0;	//<-- Children linked to entities of the pack (all child types).
+			uint32_t	numCreated				= 0;	//<-- Since the last call to the EntityManager::collect_stats.
+			uint32_t	numDestroyed			= 0;	//<-- Since the last call to the EntityManager::collect_stats.
+			uint32_t	numRelocations			= 0;	//<-- Since the last call to the EntityManager::collect_stats.
+
+			uint64_t	used_bytes() const
+			{
+				return (entitySize + componentSize) * numEntities;
+			}
+
+			uint64_t	reserved_bytes() const
+			{
+				return entitySize * capacity + componentRowBytes;
+			}
+		};
+
 	public:		// [COMMANDS]
 		class	CMD_DestroyHierarchy;
 
 	public:		// [CONSTANTS]
 		static const uint32_t INVALID_ENTITY_ID = std::numeric_limits<uint32_t>::max();
 
+	private:	// [DATA]
+		EntityPack*					m_basePack;			//<-- Pack of the base entity type (nullptr if the entity has no base).
+		std::atomic<uint64_t>		m_hierarchyVersion;	//<-- Changed when entities of this pack (or of the derived packs) move, are destroyed or related.
+
 	private:	// [LIFECYCLE]
 		CLASS_CTOR					EntityPack(						const Binding&			BINDING)
 			: Variant(BINDING)
+			, m_basePack(nullptr)
+			, m_hierarchyVersion(0)
 		{
 
 		}
@@ -491,6 +641,8 @@ namespace dpl
 
 		virtual const Identity&		guess_identity_from_byte(		const char*				ENTITY_MEMBER_BYTE_PTR) const = 0;
 
+		virtual uint32_t			guess_ID_from_byte(				const char*				ENTITY_MEMBER_BYTE_PTR) const = 0;
+
 		virtual void				for_each_dependent_child(		const std::string&		ENTITY_NAME,
 																	const Dependency		DEPENDENCY,
 																	const InvokeIdentity&	INVOKE) const = 0;
@@ -504,13 +656,55 @@ namespace dpl
 
 		virtual void				destroy_all_entities() = 0;
 
+		// Adds entities that strongly depend on the entity with the given ID to the batch (without recursion).
+		virtual void				collect_strong_dependants(		const uint32_t			ENTITY_ID,
+																	DestructionBatch&		batch) = 0;
+
+		// Given IDs must be unique and sorted in descending order.
+		virtual void				destroy_batched(				const std::vector<uint32_t>& SORTED_IDS) = 0;
+
 		virtual void				save_and_destroy(				const std::string&		ENTITY_NAME,
 																	BinaryState&			state) = 0;
 
 		virtual void				create_and_load(				const std::string&		ENTITY_NAME,
 																	BinaryState&			state) = 0;
 
+		virtual void				save_named_entity(				const std::string&		ENTITY_NAME,
+																	BinaryState&			state) const = 0;
+
+		virtual void				create_named_entity(			const std::string&		ENTITY_NAME) = 0;
+
+		virtual void				load_named_entity(				const std::string&		ENTITY_NAME,
+																	BinaryState&			state) = 0;
+
+		// Creates copies of all entities in the pack of the same type in another world (same order, names, state and components).
+		virtual void				fork_entities_to(				EntityPack&				target) = 0;
+
+		// Links copies of the entities the same way as the originals are linked.
+		virtual void				fork_relations_to(				EntityPack&				target,
+																	const EntityRemap&		REMAP) const = 0;
+
+		// Fills statistics of the pack and resets its churn counters.
+		virtual void				collect_stats(					Stats&					stats) = 0;
+
+		// Closes the frame of the create-rate history and reserves storage for the entities expected in the next one.
+		virtual void				reserve_for_next_frame() = 0;
+
 	public:		// [FUNCTIONS]
+		uint64_t					hierarchy_version() const
+		{
+			return m_hierarchyVersion.load(std::memory_order_acquire);
+		}
+
+		// Invalidates hierarchy levels cached for this pack and packs of its base types (see@ EntityManager::for_each_level).
+		void						notify_hierarchy_changed()
+		{
+			for(EntityPack* pack = this; pack; pack = pack->m_basePack)
+			{
+				pack->m_hierarchyVersion.fetch_add(1, std::memory_order_release);
+			}
+		}
+
 		template<typename MemberT>
 		const Identity&				guess_identity(					const MemberT*			ENTITY_MEMBER) const
 		{
@@ -541,6 +735,147 @@ namespace dpl
 	};
 
 
+	/*
+		Gathers the entities that must be destroyed together (given entities and everything that strongly depends on them),
+		then removes them pack by pack in descending order of their IDs, so that swap-removal never invalidates pending IDs.
+	*/
+	class	EntityPack::DestructionBatch
+	{
+	private:	// [SUBTYPES]
+		struct	Entry
+		{
+			uint32_t		packID; // Index in the m_packs.
+			uint32_t		entityID;
+			const Identity*	identity;
+
+			bool operator<(const Entry& OTHER) const
+			{
+				// Packs discovered later (dependants) go first, then IDs in descending order.
+				if(packID != OTHER.packID) return packID > OTHER.packID;
+				return entityID > OTHER.entityID;
+			}
+
+			bool operator==(const Entry& OTHER) const
+			{
+				return (packID == OTHER.packID) && (entityID == OTHER.entityID);
+			}
+		};
+
+	private:	// [DATA]
+		std::vector<EntityPack*>	m_packs;
+		std::vector<Entry>			m_entries;
+		uint32_t					m_numExpanded;
+		bool						m_sorted;
+
+	public:		// [LIFECYCLE]
+		CLASS_CTOR		DestructionBatch()
+			: m_numExpanded(0)
+			, m_sorted(true)
+		{
+
+		}
+
+	public:		// [FUNCTIONS]
+		// Adds single entity (without dependants).
+		void			add(			EntityPack&					pack,
+										const uint32_t				ENTITY_ID,
+										const Identity&				IDENTITY)
+		{
+			m_entries.push_back({get_packID(pack), ENTITY_ID, &IDENTITY});
+			m_sorted = false;
+		}
+
+		bool			add(			const Identity&				IDENTITY);
+
+		// Adds given entity and all entities that strongly depend on it.
+		void			add_hierarchy(	EntityPack&					pack,
+										const uint32_t				ENTITY_ID,
+										const Identity&				IDENTITY)
+		{
+			DestructionBatch::add(pack, ENTITY_ID, IDENTITY);
+			DestructionBatch::expand();
+		}
+
+		void			add_hierarchy(	const Identity&				IDENTITY)
+		{
+			if(DestructionBatch::add(IDENTITY)) expand();
+		}
+
+		uint32_t		size()
+		{
+			DestructionBatch::sort();
+			return (uint32_t)m_entries.size();
+		}
+
+		void			for_each(		const InvokeIdentity&		INVOKE)
+		{
+			DestructionBatch::sort();
+			for(const Entry& ENTRY : m_entries)
+			{
+				INVOKE(*ENTRY.identity);
+			}
+		}
+
+		// Destroys all entities in the batch and clears it.
+		void			destroy()
+		{
+			DestructionBatch::sort();
+
+			std::vector<uint32_t> sortedIDs;
+			for(auto begin = m_entries.begin(); begin != m_entries.end();)
+			{
+				const uint32_t PACK_ID = begin->packID;
+
+				sortedIDs.clear();
+				for(; begin != m_entries.end() && begin->packID == PACK_ID; ++begin)
+				{
+					sortedIDs.push_back(begin->entityID);
+				}
+
+				m_packs[PACK_ID]->destroy_batched(sortedIDs);
+			}
+
+			m_packs.clear();
+			m_entries.clear();
+			m_numExpanded	= 0;
+			m_sorted		= true;
+		}
+
+	private:	// [INTERNAL FUNCTIONS]
+		uint32_t		get_packID(		EntityPack&					pack)
+		{
+			// Batches rarely span more than a few packs, linear search is fine.
+			for(uint32_t packID = (uint32_t)m_packs.size(); packID-- > 0;)
+			{
+				if(m_packs[packID] == &pack) return packID;
+			}
+
+			m_packs.push_back(&pack);
+			return (uint32_t)m_packs.size() - 1;
+		}
+
+		// Breadth-first, so that deep hierarchies do not exhaust the stack.
+		void			expand()
+		{
+			for(; m_numExpanded < m_entries.size(); ++m_numExpanded)
+			{
+				const Entry ENTRY = m_entries[m_numExpanded]; //<-- Copy, entries may be reallocated.
+				m_packs[ENTRY.packID]->collect_strong_dependants(ENTRY.entityID, *this);
+			}
+		}
+
+		// Orders entries for destruction and removes duplicates (entity may depend on more than one collected parent).
+		void			sort()
+		{
+			if(m_sorted) return;
+			std::sort(m_entries.begin(), m_entries.end());
+			m_entries.erase(std::unique(m_entries.begin(), m_entries.end()), m_entries.end());
+			m_numExpanded	= (uint32_t)m_entries.size();
+			m_sorted		= true;
+		}
+	};
+
+
 	class	EntityManager	: public dpl::Singleton<EntityManager>
 							, private dpl::Variation<EntityManager, EntityPack>
 							, private dpl::StaticHolder<Identity, EntityManager>
@@ -548,10 +883,43 @@ namespace dpl
 	public:		// [FRIENDS]
 		friend EntityPack;
 		friend Identity;
+		friend class Reference;
+
+		template<typename>
+		friend class Entity;
 
 		template<typename>
 		friend class EntityPack_of;
 
+		template<typename, dpl::is_TypeList>
+		friend class Parent;
+
+	private:	// [SUBTYPES]
+		// Children of the parent-child relation sorted by depth (see@ for_each_level), immutable once built.
+		struct	HierarchyLevels
+		{
+			std::vector<void*>		children;
+			std::vector<uint32_t>	levelEnds;	//<-- One past the last child of each level.
+			uint64_t				version	= 0;	//<-- Sum of the hierarchy versions of the parent and child packs.
+		};
+
+		// Memory reserved by the pack for its entities.
+		struct	StorageRange
+		{
+			const char*	begin;
+			const char*	end;
+			EntityPack*	pack;
+		};
+
+	private:	// [CONSTANTS]
+		static const uint32_t MIN_PARALLEL_LEVEL_SIZE = 64; //<-- Smaller levels are processed on the calling thread.
+
+	private:	// [DATA]
+		std::mutex																m_hierarchyMtx;		//<-- Guards m_hierarchyLevels (not the snapshots, they are never modified).
+		std::unordered_map<std::type_index, std::shared_ptr<const HierarchyLevels>>	m_hierarchyLevels;
+		mutable std::shared_mutex								m_storageMtx;		//<-- Guards m_storageRanges, packs may relocate concurrently.
+		std::vector<StorageRange>								m_storageRanges;	//<-- Sorted by the first byte.
+
 #ifdef USE_COMMANDS_TO_MANAGE_ENTITIES
 	public:		// [COMMANDS]
 		template<typename T>
@@ -635,7 +1003,7 @@ namespace dpl
 		{
 			EntityManager::assure_pack_of<T>();
 			m_invoker.invoke<CMD_Create<T>>(NAME);
-			return EntityPack_of<T>::ref().last();
+			return EntityPack_of<T>::ref().last_active();
 		}
 
 		template<is_Entity T>
@@ -644,7 +1012,7 @@ namespace dpl
 		{
 			EntityManager::assure_pack_of<T>();
 			m_invoker.invoke<CMD_Create<T>>(TYPE, STR);
-			return EntityPack_of<T>::ref().last();
+			return EntityPack_of<T>::ref().last_active();
 		}
 
 		template<is_Entity T>
@@ -851,84 +1219,385 @@ namespace dpl
 			EntityPack_of<T>::ref().for_each_in_parallel(phase, INVOKE);
 		}
 
-	public:		// [FUNCTIONS]
-		static const Identity&	false_identity()
+	public:		// [HIERARCHY ITERATION]
+		/*
+			Invokes children of the given type level by level, starting with children of the root parents (parents without parents).
+			Children at the same depth are processed in parallel and all of them are finished before the next level starts,
+			so the parent of the invoked child is always processed first (if ParentT is the same as ChildT).
+			Level decomposition is cached and rebuilt only after entities of ParentT or ChildT (or derived types) are related, moved or destroyed.
+			Each call iterates its own immutable snapshot of the levels, so a rebuild requested by another thread does not affect it.
+			NOTE: Relations of the iterated entities must not be modified during iteration.
+		*/
+		template<is_Entity ParentT, one_of_child_types_of<ParentT> ChildT>
+		void					for_each_level(				dpl::ParallelPhase&							phase,
+															const InvokeEntity<ChildT>&					INVOKE)
 		{
-			return StaticHolder::data;
-		}
+			const std::shared_ptr<const HierarchyLevels>	SNAPSHOT	= EntityManager::get_hierarchy_levels<ParentT, ChildT>();
+			const HierarchyLevels&							LEVELS		= *SNAPSHOT;
 
-	private:	// [INTERNAL FUNCTIONS]
-		template<is_Entity T>
-		bool					create_EntityPack_of()
-		{
-			return Variation::create_variant<EntityPack_of<T>>();
+			uint32_t levelBegin = 0;
+			for(const uint32_t LEVEL_END : LEVELS.levelEnds)
+			{
+				const dpl::IndexRange<> RANGE_OF_CHILDREN(levelBegin, LEVEL_END);
+				if(RANGE_OF_CHILDREN.size() < MIN_PARALLEL_LEVEL_SIZE)
+				{
+					RANGE_OF_CHILDREN.for_each([&](const uint32_t INDEX)
+					{
+						INVOKE(*static_cast<ChildT*>(LEVELS.children[INDEX]));
+					});
+				}
+				else
+				{
+					dpl::parallel_for(phase, RANGE_OF_CHILDREN, [&](const dpl::IndexRange<>& SUBRANGE)
+					{
+						SUBRANGE.for_each([&](const uint32_t INDEX)
+						{
+							INVOKE(*static_cast<ChildT*>(LEVELS.children[INDEX]));
+						});
+					}); //<-- Barrier between levels.
+				}
+
+				levelBegin = LEVEL_END;
+			}
 		}
 
+	public:		// [FUNCTIONS]
+		// Not synchronized, packs used by concurrently updated systems are created before the update (see@ Preparation_of).
 		template<is_Entity T>
 		void					assure_pack_of()
 		{
 			if(!EntityPack_of<T>::ptr()) EntityManager::create_EntityPack_of<T>();
 		}
 
-		void					destroy_all_entities()
+		static const Identity&	false_identity()
 		{
-			Variation::for_each_variant([](EntityPack& pack)
+			return StaticHolder::data;
+		}
+
+		// Returns identity of the entity that contains given address (any pack), or false identity.
+		const Identity&			identity_from_address(		const void*									ADDRESS) const
+		{
+			const char*			BYTE_PTR	= static_cast<const char*>(ADDRESS);
+			std::shared_lock	lk(m_storageMtx);
+			auto				it			= std::upper_bound(m_storageRanges.begin(), m_storageRanges.end(), BYTE_PTR, [](const char* BYTE, const StorageRange& RANGE)
 			{
-				pack.destroy_all_entities();
+				return BYTE < RANGE.begin;
 			});
+
+			if(it == m_storageRanges.begin()) return false_identity();
+			--it;
+			if(BYTE_PTR >= it->end) return false_identity();
+			return it->pack->guess_identity_from_byte(BYTE_PTR);
 		}
-	};
 
+		/*
+			Copies all entities of this world to the given manager of another world (target must not have any packs yet).
+			Copies are stored at the same indices, have the same names, state(see@ Entity::save_state) and components.
+			Component rows are shared copy-on-write by both worlds, each page is copied by the world that accesses it first (see@ CopyOnWritePages).
+			Relations are cloned by translating addresses between the packs of both worlds, without name lookup.
+			The calling thread stays bound to its current world after the fork.
+		*/
+		void					fork_to(					EntityManager&								target)
+		{
+			if(&target == this || target.get_numVariants() > 0)
+				throw dpl::GeneralException(this, __LINE__, "Fail to fork. Target manager must belong to another world and have no packs.");
 
-	inline const std::string&	Identity::get_typeName() const
-	{
-		EntityPack* pack = EntityManager::ref().find_base_variant(storageID());
-		return pack? pack->get_entity_typeName() : "??unknown_entity_type??";
-	}
-}
+			ScopedWorld targetWorld(target.owner()); //<-- Copies are created through the singletons of the target world.
 
-// references				(internal, RTTI)
-namespace dpl
-{
-	class	Reference
-	{
-	public:		// [DATA]
-		dpl::ReadOnly<Identity::StorageID,	Reference> storageID;
-		dpl::ReadOnly<std::string,			Reference> name;
+			const uint32_t NUM_TYPES = EntityPack::count_typeIDs();
+			for(uint32_t typeID = 0; typeID < NUM_TYPES; ++typeID)
+			{
+				if(EntityPack* pack = Variation::find_base_variant(typeID))
+				{
+					pack->fork_entities_to(*target.create_default_variant(typeID).get());
+				}
+			}
 
-	public:		// [LIFECYCLE]
-		CLASS_CTOR					Reference()
-			: storageID(EntityPack::INVALID_INDEX)
-		{
+			EntityRemap remap; //<-- Built after all copies are created, so the target packs will not relocate.
+			for(uint32_t typeID = 0; typeID < NUM_TYPES; ++typeID)
+			{
+				const StorageRange SOURCE_RANGE = find_storage_range(Variation::find_base_variant(typeID));
+				const StorageRange TARGET_RANGE = target.find_storage_range(target.find_base_variant(typeID));
+				if(SOURCE_RANGE.pack && TARGET_RANGE.pack)
+				{
+					remap.add(SOURCE_RANGE.begin, SOURCE_RANGE.end, const_cast<char*>(TARGET_RANGE.begin));
+				}
+			}
+
+			for(uint32_t typeID = 0; typeID < NUM_TYPES; ++typeID)
+			{
+				if(const EntityPack* PACK = Variation::find_base_variant(typeID))
+				{
+					PACK->fork_relations_to(*target.find_base_variant(typeID), remap);
+				}
+			}
 		}
 
-		CLASS_CTOR					Reference(				const Identity&			IDENTITY)
-			: storageID(IDENTITY.storageID())
-			, name(IDENTITY.name())
+		/*
+			Pre-reserves storage of all packs for the entities they are expected to create in the next frame, based on their recent create rates.
+			Call on the main thread at the beginning of the frame (Application does it every cycle), so that entity storage is not relocated in the middle of the frame.
+		*/
+		void					reserve_for_next_frame()
 		{
-
+			Variation::for_each_variant([](EntityPack& pack)
+			{
+				pack.reserve_for_next_frame();
+			});
 		}
 
-		CLASS_CTOR					Reference(				BinaryState&			state)
-			: Reference()
+		// Returns statistics of all packs and resets their churn counters (creates, destroys and relocations since the last call).
+		std::vector<EntityPack::Stats>	collect_stats()
 		{
-			load_from_binary(state);
+			std::vector<EntityPack::Stats> stats;
+			stats.reserve(Variation::get_numVariants());
+			Variation::for_each_variant([&](EntityPack& pack)
+			{
+				pack.collect_stats(stats.emplace_back());
+			});
+			return stats;
 		}
 
-		template<typename EntityT>
-		CLASS_CTOR					Reference(				const Entity<EntityT>*	ENTITY)
-			: Reference()
+		static void				log_stats(					const std::vector<EntityPack::Stats>&		STATS)
 		{
-			Reference::reset<EntityT>(ENTITY);
+			dpl::Logger& logger = dpl::Logger::ref();
+			for(const EntityPack::Stats& PACK : STATS)
+			{
+				logger.push_info("EntityPack[%s]: entities: %u/%u (active/all), capacity: %u, used: %llu B, reserved: %llu B",
+								PACK.typeName.c_str(), PACK.numActive, PACK.numEntities, PACK.capacity, 
+								(unsigned long long)PACK.used_bytes(), (unsigned long long)PACK.reserved_bytes());
+				logger.push_info("    entity: %llu B, components: %llu B, component rows: %llu B reserved, rows: %u dense, %u tag, %u sparse (%u components)",
+								(unsigned long long)PACK.entitySize, (unsigned long long)PACK.componentSize, (unsigned long long)PACK.componentRowBytes,
+								PACK.numComponentRows, PACK.numTagRows, PACK.numSparseRows, PACK.numSparseComponents);
+				logger.push_info("    labeler: load factor: %.2f, buckets: %u, relations: %u parent, %u child, %u partner types (%llu children)",
+								PACK.labelerLoadFactor, PACK.labelerNumBuckets, PACK.numParentTypes, PACK.numChildTypes, PACK.numPartnerTypes,
+								(unsigned long long)PACK.numChildren);
+				logger.push_info("    churn: %u created, %u destroyed, %u relocations", PACK.numCreated, PACK.numDestroyed, PACK.numRelocations);
+			}
 		}
 
-	public:		// [OPERATORS]
-		bool						operator==(				const Reference&		OTHER) const
+	private:	// [INTERNAL FUNCTIONS]
+		template<is_Entity T>
+		bool					create_EntityPack_of()
 		{
-			return (this->storageID() == OTHER.storageID()) && (this->name() == OTHER.name());
+			return Variation::create_variant<EntityPack_of<T>>();
 		}
 
-		bool						operator!=(				const Reference&		OTHER) const
+		void					destroy_all_entities()
+		{
+			Variation::for_each_variant([](EntityPack& pack)
+			{
+				pack.destroy_all_entities();
+			});
+		}
+
+		// Invalidates cached hierarchy levels of the given entity types (packs that were not created yet are skipped).
+		template<is_Entity... EntityTn>
+		static void				notify_hierarchy_changed()
+		{
+			(..., std::invoke([](EntityPack* pack)
+			{
+				if(pack) pack->notify_hierarchy_changed();
+
+			}, EntityPack_of<EntityTn>::ptr()));
+		}
+
+		// Called by the pack after reallocation of its entities.
+		void					update_storage_range(		EntityPack&									pack,
+															const char*									BEGIN,
+															const char*									END)
+		{
+			std::unique_lock lk(m_storageMtx);
+			auto it = std::find_if(m_storageRanges.begin(), m_storageRanges.end(), [&](const StorageRange& RANGE)
+			{
+				return RANGE.pack == &pack;
+			});
+			if(it != m_storageRanges.end()) m_storageRanges.erase(it);
+			if(BEGIN == END) return;
+
+			it = std::upper_bound(m_storageRanges.begin(), m_storageRanges.end(), BEGIN, [](const char* BYTE, const StorageRange& RANGE)
+			{
+				return BYTE < RANGE.begin;
+			});
+			m_storageRanges.insert(it, StorageRange{BEGIN, END, &pack});
+		}
+
+		// Returns copy of the range reserved by the PACK, its pack is nullptr if not found.
+		StorageRange			find_storage_range(			const EntityPack*							PACK) const
+		{
+			if(!PACK) return StorageRange{nullptr, nullptr, nullptr};
+			std::shared_lock lk(m_storageMtx);
+			auto it = std::find_if(m_storageRanges.begin(), m_storageRanges.end(), [&](const StorageRange& RANGE)
+			{
+				return RANGE.pack == PACK;
+			});
+			return (it != m_storageRanges.end())? *it : StorageRange{nullptr, nullptr, nullptr};
+		}
+
+		// Links the copy of the entity (and its base) the same way as the source is linked (see@ fork_to).
+		template<is_Entity EntityT>
+		static void				fork_relations_of(			const EntityT&								SOURCE,
+															EntityT&									clone,
+															const EntityRemap&							REMAP);
+
+		// Returns copy of the related entity, throws if the SOURCE is not stored in any of the forked packs.
+		template<typename T>
+		static T&				remap_or_throw(				const T*									SOURCE,
+															const EntityRemap&							REMAP)
+		{
+			if(T* clone = REMAP(SOURCE)) return *clone;
+			throw dpl::GeneralException(__FILE__, __LINE__, std::string("Fail to fork relation. Related entity is not stored in any pack: ") + typeid(T).name());
+		}
+
+		template<is_Entity EntityT>
+		static uint64_t			hierarchy_version_of()
+		{
+			const EntityPack* PACK = EntityPack_of<EntityT>::ptr();
+			return PACK? PACK->hierarchy_version() : 0;
+		}
+
+		/*
+			Returns the cached snapshot, or replaces it with a new one if the packs of ParentT or ChildT changed since it was built.
+			Versions are read before the levels, so changes made during the rebuild invalidate the new snapshot too.
+		*/
+		template<is_Entity ParentT, one_of_child_types_of<ParentT> ChildT>
+		std::shared_ptr<const HierarchyLevels>	get_hierarchy_levels()
+		{
+			uint64_t version = hierarchy_version_of<ParentT>();
+			if constexpr (!std::is_same_v<ParentT, ChildT>) version += hierarchy_version_of<ChildT>(); //<-- Versions only grow, so the sum changes with any of them.
+
+			std::lock_guard lk(m_hierarchyMtx);
+			std::shared_ptr<const HierarchyLevels>& cached = m_hierarchyLevels[typeid(Relation_between<ParentT, ChildT>)];
+			if(cached && cached->version == version) return cached;
+
+			std::shared_ptr<HierarchyLevels>	rebuilt	= std::make_shared<HierarchyLevels>();
+			HierarchyLevels&					levels	= *rebuilt;
+			levels.version = version;
+
+			auto add_children_of = [&](ParentT& parent)
+			{
+				parent.template for_each_child<ChildT>([&](ChildT& child)
+				{
+					levels.children.push_back(&child);
+				});
+			};
+
+			if(EntityPack_of<ParentT>* pack = EntityPack_of<ParentT>::ptr())
+			{
+				pack->for_each([&](EntityPackView<ParentT>& view)
+				{
+					for(uint32_t index = 0; index < view.numEntities(); ++index)
+					{
+						ParentT& parent = view.entity_at(index);
+						if constexpr (std::is_same_v<ParentT, ChildT>)
+						{
+							if(parent.template has_parent<ParentT>()) continue; //<-- Not a root.
+						}
+						add_children_of(parent);
+					}
+				});
+			}
+
+			uint32_t levelBegin = 0;
+			while(levelBegin < levels.children.size())
+			{
+				const uint32_t LEVEL_END = (uint32_t)levels.children.size();
+				levels.levelEnds.push_back(LEVEL_END);
+				if constexpr (std::is_same_v<ParentT, ChildT>)
+				{
+					for(uint32_t index = levelBegin; index < LEVEL_END; ++index)
+					{
+						add_children_of(*static_cast<ChildT*>(levels.children[index]));
+					}
+				}
+				levelBegin = LEVEL_END;
+			}
+
+			cached = std::move(rebuilt);
+			return cached;
+		}
+	};
+
+
+	template<typename T>
+	struct	Preparation_of; //<-- Declared by the SystemManager.
+
+	// Pack of the entity type declared in Access_of is created before the systems are updated concurrently.
+	template<is_Entity T>
+	struct	Preparation_of<T>
+	{
+		static void prepare()
+		{
+			EntityManager::ref().assure_pack_of<T>();
+		}
+	};
+
+
+	inline const std::string&	Identity::get_typeName() const
+	{
+		static const std::string UNKNOWN_TYPE_NAME = "??unknown_entity_type??";
+		EntityPack* pack = EntityManager::ref().find_base_variant(storageID());
+		return pack? pack->get_entity_typeName() : UNKNOWN_TYPE_NAME;
+	}
+
+
+	inline bool		EntityPack::DestructionBatch::add(	const Identity&		IDENTITY)
+	{
+		EntityPack* pack = EntityManager::ref().find_base_variant(IDENTITY.storageID());
+		if(!pack)
+		{
+			dpl::Logger::ref().push_error("Fail to destroy: %s -> Could not find pack with given ID[%d]", IDENTITY.name().c_str(), IDENTITY.storageID());
+			return false;
+		}
+
+		const uint32_t ENTITY_ID = pack->guess_ID_from_byte(reinterpret_cast<const char*>(&IDENTITY));
+		if(ENTITY_ID == EntityPack::INVALID_ENTITY_ID) return false;
+		DestructionBatch::add(*pack, ENTITY_ID, IDENTITY);
+		return true;
+	}
+}
+
+// references				(internal, RTTI)
+namespace dpl
+{
+	class	Reference
+	{
+	public:		// [DATA]
+		dpl::ReadOnly<Identity::StorageID,	Reference> storageID;
+		dpl::ReadOnly<std::string,			Reference> name;
+
+	public:		// [LIFECYCLE]
+		CLASS_CTOR					Reference()
+			: storageID(EntityPack::INVALID_INDEX)
+		{
+		}
+
+		CLASS_CTOR					Reference(				const Identity&			IDENTITY)
+			: storageID(IDENTITY.storageID())
+			, name(IDENTITY.name())
+		{
+
+		}
+
+		CLASS_CTOR					Reference(				BinaryState&			state)
+			: Reference()
+		{
+			load_from_binary(state);
+		}
+
+		template<typename EntityT>
+		CLASS_CTOR					Reference(				const Entity<EntityT>*	ENTITY)
+			: Reference()
+		{
+			Reference::reset<EntityT>(ENTITY);
+		}
+
+	public:		// [OPERATORS]
+		bool						operator==(				const Reference&		OTHER) const
+		{
+			return (this->storageID() == OTHER.storageID()) && (this->name() == OTHER.name());
+		}
+
+		bool						operator!=(				const Reference&		OTHER) const
 		{
 			return !Reference::operator==(OTHER);
 		}
@@ -1009,13 +1678,13 @@ namespace dpl
 // relation declarations	(internal)
 namespace dpl
 {
-	template<typename ParentT, typename ChildT, RelationType TYPE>
+	template<typename ParentT, typename ChildT, RelationType TYPE, RelationStorage STORAGE = LINKED_STORAGE>
 	class	ChildBase;
 
 	template<typename MeT, typename YouT>
 	class	PartnerBase;
 
-	template<typename ParentT, typename ChildT, RelationType TYPE>
+	template<typename ParentT, typename ChildT, RelationType TYPE, RelationStorage STORAGE = LINKED_STORAGE>
 	class	ParentBase;
 
 
@@ -1052,6 +1721,19 @@ namespace dpl
 		return Relation_between<ParentT, ChildT>::DEPENDENCY;
 	}
 
+	template<typename ParentT, typename ChildT>
+	constexpr RelationStorage	get_relation_storage()
+	{
+		constexpr RelationType TYPE = dpl::get_relation_between<ParentT, ChildT>();
+		if constexpr(TYPE != ONE_TO_ONE && TYPE != ONE_TO_MANY)	return CONTIGUOUS_STORAGE;
+		else													return Relation_between<ParentT, ChildT>::STORAGE;
+	}
+
+	constexpr uint32_t		get_max_children(const RelationType TYPE)
+	{
+		return (TYPE == ONE_TO_MANY)? 0 : static_cast<uint32_t>(TYPE); //<-- 0 means no limit
+	}
+
 	template<typename ParentT, typename ChildT>
 	constexpr bool			are_strongly_dependant()
 	{
@@ -1060,10 +1742,10 @@ namespace dpl
 
 
 	template<typename ParentT, typename ChildT>
-	using	ParentBase_t	= ParentBase<ParentT, ChildT, dpl::get_relation_between<ParentT, ChildT>()>;
+	using	ParentBase_t	= ParentBase<ParentT, ChildT, dpl::get_relation_between<ParentT, ChildT>(), dpl::get_relation_storage<ParentT, ChildT>()>;
 
 	template<typename ParentT, typename ChildT>
-	using	ChildBase_t		= ChildBase<ParentT, ChildT, dpl::get_relation_between<ParentT, ChildT>()>;
+	using	ChildBase_t		= ChildBase<ParentT, ChildT, dpl::get_relation_between<ParentT, ChildT>(), dpl::get_relation_storage<ParentT, ChildT>()>;
 }
 
 // Child interface			(internal)
@@ -1247,6 +1929,96 @@ namespace dpl
 	};
 
 
+	// Child of the ONE_TO_MANY relation with contiguous storage, or the ONE_TO_SPECIFIC_NUMBER relation.
+	template<typename ChildT, typename ParentT, RelationType TYPE>
+	class	ChildBase<ParentT, ChildT, TYPE, RelationStorage::CONTIGUOUS_STORAGE> 
+		: private dpl::DenseMember<ParentT, ChildT, dpl::get_relation_ID<ParentT, ChildT>(), dpl::get_max_children(TYPE)>
+	{
+	private:	// [SUBTYPES]
+		static const uint32_t RELATION_ID	= dpl::get_relation_ID<ParentT, ChildT>();
+		static const uint32_t MAX_CHILDREN	= dpl::get_max_children(TYPE);
+		using	ParentBaseT					= ParentBase<ParentT, ChildT, TYPE, RelationStorage::CONTIGUOUS_STORAGE>;
+		using	MyMemberT					= dpl::DenseMember<ParentT, ChildT, RELATION_ID, MAX_CHILDREN>;
+		using	MyGroupT					= dpl::DenseGroup<ParentT, ChildT, RELATION_ID, MAX_CHILDREN>;
+
+	public:		// [FRIENDS]
+		friend	ParentBaseT;
+		friend	MyMemberT;
+		friend	MyGroupT;
+
+		template<typename, dpl::is_TypeList>
+		friend class	Parent;
+
+		template<typename, dpl::is_TypeList>
+		friend class	Child;
+
+	protected:	// [LIFECYCLE]
+		CLASS_CTOR			ChildBase() = default;
+		CLASS_CTOR			ChildBase(			ChildBase&&				other) noexcept = default;
+		ChildBase&			operator=(			ChildBase&&				other) noexcept = default;
+
+	private:	// [LIFECYCLE] (deleted)
+		CLASS_CTOR			ChildBase(			const ChildBase&		OTHER) = delete;
+		ChildBase&			operator=(			const ChildBase&		OTHER) = delete;
+
+	private:	// [FUNCTIONS]
+		bool				has_parent() const
+		{
+			return MyMemberT::is_member();
+		}
+
+		ParentT&			get_parent()
+		{
+			return *MyMemberT::get_group();
+		}
+
+		const ParentT&		get_parent() const
+		{
+			return *MyMemberT::get_group();
+		}
+
+		ChildT*				get_prev_sibling()
+		{
+			return MyMemberT::previous();
+		}
+
+		const ChildT*		get_prev_sibling() const
+		{
+			return MyMemberT::previous();
+		}
+
+		ChildT*				get_next_sibling()
+		{
+			return MyMemberT::next();
+		}
+
+		const ChildT*		get_next_sibling() const
+		{
+			return MyMemberT::next();
+		}
+
+		void				save_parent(		BinaryState&			state) const
+		{
+			Reference::save_to_binary_opt(MyMemberT::get_group(), state);
+		}
+
+		void				load_parent(		BinaryState&			state)
+		{
+			MyMemberT::detach();
+			const Reference REFERENCE(state);
+			if(ParentBaseT* parent = REFERENCE.find<ParentT>()) 
+			{
+				if(!parent->add_end_member(*this))
+					dpl::Logger::ref().push_error("Fail to import relation. The specified parent cannot have more children: " + REFERENCE.name());
+			}
+			else // log error
+			{
+				dpl::Logger::ref().push_error("Fail to import relation. The specified parent could not be found: " + REFERENCE.name());
+			}
+		}
+	};
+
+
 	template<typename ChildT, typename... ParentTn>
 	class	Child<ChildT, dpl::TypeList<ParentTn...>>	: public MaybeIdentified<ChildT>
 														, public ChildBase_t<ParentTn, ChildT>...
@@ -1445,7 +2217,7 @@ namespace dpl
 		bool				remove_partner(					YouT&					partner)
 		{
 			if(MyBaseT::other() != &partner) return false;
-			return Partner::remove_partner();
+			return PartnerBase::remove_partner();
 		}
 
 		YouT&				get_partner()
@@ -1649,158 +2421,360 @@ namespace dpl
 
 	private: // lifecycle
 		CLASS_CTOR			ParentBase() = default;
-		CLASS_CTOR			ParentBase(						ParentBase&&					other) noexcept = default;
-		ParentBase&			operator=(						ParentBase&&					other) noexcept = default;
+		CLASS_CTOR			ParentBase(						ParentBase&&					other) noexcept = default;
+		ParentBase&			operator=(						ParentBase&&					other) noexcept = default;
+
+	private: // lifecycle (deleted)
+		CLASS_CTOR			ParentBase(						const ParentBase&				OTHER) = delete;
+		ParentBase&			operator=(						const ParentBase&				OTHER) = delete;
+
+	private: // functions
+		bool				has_child() const
+		{
+			return MyBaseT::is_linked();
+		}
+
+		bool				can_have_another_child() const
+		{
+			return !has_child();
+		}
+
+		uint32_t			numChildren() const
+		{
+			return has_child()? 1 : 0;
+		}
+
+		bool				add_child(						ChildT&							child)
+		{
+			return MyBaseT::link(child);
+		}
+
+		bool				remove_child(					ChildT&							child)
+		{
+			if(MyBaseT::other() != &child) return false;
+			return MyBaseT::unlink();
+		}
+
+		bool				remove_all_children()
+		{
+			return MyBaseT::unlink();
+		}
+
+		void				destroy_all_children()
+		{
+			if(this->has_child())
+			{
+				EntityPack::DestructionBatch batch;
+				batch.add_hierarchy(get_child());
+				batch.destroy();
+			}
+		}
+
+		ChildT&				get_child()
+		{
+			return *MyBaseT::other();
+		}
+
+		const ChildT&		get_child() const
+		{
+			return *MyBaseT::other();
+		}
+
+		ChildT*				first_child()
+		{
+			return MyBaseT::other();
+		}
+
+		const ChildT*		first_child() const
+		{
+			return MyBaseT::other();
+		}
+
+		ChildT*				last_child()
+		{
+			return MyBaseT::other();
+		}
+
+		const ChildT*		last_child() const
+		{
+			return MyBaseT::other();
+		}
+
+		ChildT*				previous_child(					MyLinkT&						child)
+		{
+			return nullptr;
+		}
+
+		const ChildT*		previous_child(					const MyLinkT&					CHILD) const
+		{
+			return nullptr;
+		}
+
+		ChildT*				next_child(						MyLinkT&						child)
+		{
+			return nullptr;
+		}
+
+		const ChildT*		next_child(						const MyLinkT&					CHILD) const
+		{
+			return nullptr;
+		}
+
+		uint32_t			for_each_child(					const InvokeChild&				INVOKE_CHILD)
+		{
+			if(!has_child()) return 0;
+			INVOKE_CHILD(get_child());
+			return 1;
+		}
+
+		uint32_t			for_each_child(					const InvokeConstChild&			INVOKE_CHILD) const
+		{
+			if(!has_child()) return 0;
+			INVOKE_CHILD(get_child());
+			return 1;
+		}
+
+		uint32_t			for_each_child_until(			const InvokeChildUntil&			INVOKE_CHILD)
+		{
+			return ParentBase::for_each_child([&](ChildT& child){ INVOKE_CHILD(child); });
+		}
+
+		uint32_t			for_each_child_until(			const InvokeConstChildUntil&	INVOKE_CHILD) const
+		{
+			return ParentBase::for_each_child([&](const ChildT& CHILD){ INVOKE_CHILD(CHILD); });
+		}
+
+		void				save_children(					BinaryState&					state) const
+		{
+			Reference::save_to_binary_opt(first_child(), state);
+		}
+
+		void				load_children(					BinaryState&					state)
+		{
+			MyBaseT::unlink();
+			const Reference REFERENCE(state);
+			if(ChildBaseT* child = REFERENCE.find<ChildT>())
+			{
+				MyBaseT::link(*child);
+			}
+			else // log error
+			{
+				dpl::Logger::ref().push_error("Fail to import relation. The specified child could not be found: " + REFERENCE.name());
+			}
+		}
+	};
+
+
+	template<typename ParentT, typename ChildT>
+	class	ParentBase<ParentT, ChildT, RelationType::ONE_TO_MANY> 
+		: private dpl::Group<ParentT, ChildT, dpl::get_relation_ID<ParentT, ChildT>()>
+	{
+	private: // subtypes
+		static const uint32_t RELATION_ID	= dpl::get_relation_ID<ParentT, ChildT>();
+		using	ChildBaseT					= ChildBase<ParentT, ChildT, RelationType::ONE_TO_MANY>;
+		using	MyMemberT					= dpl::Member<ParentT, ChildT, RELATION_ID>;
+		using	MyGroupT					= dpl::Group<ParentT, ChildT, RELATION_ID>;
+
+	public: // subtypes
+		using	InvokeChild					= std::function<void(ChildT&)>;
+		using	InvokeConstChild			= std::function<void(const ChildT&)>;
+		using	InvokeChildUntil			= std::function<bool(ChildT&)>;
+		using	InvokeConstChildUntil		= std::function<bool(const ChildT&)>;
+
+	public: // friends
+		friend	ChildBaseT;
+		friend	MyMemberT;
+		friend	MyGroupT;
+
+		template<typename, dpl::is_TypeList>
+		friend class	Parent;
+
+		template<typename, dpl::is_TypeList>
+		friend class	Child;
+
+	private: // lifecycle
+		CLASS_CTOR			ParentBase() = default;
+		CLASS_CTOR			ParentBase(					ParentBase&&					other) noexcept = default;
+		ParentBase&			operator=(					ParentBase&&					other) noexcept = default;
 
 	private: // lifecycle (deleted)
-		CLASS_CTOR			ParentBase(						const ParentBase&				OTHER) = delete;
-		ParentBase&			operator=(						const ParentBase&				OTHER) = delete;
+		CLASS_CTOR			ParentBase(					const ParentBase&				OTHER) = delete;
+		ParentBase&			operator=(					const ParentBase&				OTHER) = delete;
 
 	private: // functions
 		bool				has_child() const
 		{
-			return MyBaseT::is_linked();
+			return MyGroupT::size() > 0;
 		}
 
 		bool				can_have_another_child() const
 		{
-			return !has_child();
+			return true;
 		}
 
 		uint32_t			numChildren() const
 		{
-			return has_child()? 1 : 0;
+			return MyGroupT::size();
 		}
-
-		bool				add_child(						ChildT&							child)
+			
+		bool				add_child(					ChildT&							child)
 		{
-			return MyBaseT::link(child);
+			/*
+			if (ChildFilter<ParentT, ChildT>()(static_cast<const ParentT&>(*this), child))
+			{
+				// TODO: add member here
+			}
+			*/
+			return MyGroupT::add_end_member(child);
 		}
 
-		bool				remove_child(					ChildT&							child)
+		bool				remove_child(				ChildT&							child)
 		{
-			if(MyBaseT::other() != &child) return false;
-			return MyBaseT::unlink();
+			return MyGroupT::remove_member(child);
 		}
 
 		bool				remove_all_children()
 		{
-			return MyBaseT::unlink();
+			return MyGroupT::remove_all_members();
 		}
 
 		void				destroy_all_children()
 		{
-			if(this->has_child())
+			EntityPack::DestructionBatch batch;
+			ParentBase::for_each_child([&](const ChildT& CHILD) 
 			{
-				Entity<ChildT>& entity = *first_child();
-								entity.selfdestruct();
-			}
+				batch.add_hierarchy(CHILD);
+			});
+			batch.destroy();
 		}
 
 		ChildT&				get_child()
 		{
-			return *MyBaseT::other();
+			return *MyGroupT::first();
 		}
 
 		const ChildT&		get_child() const
 		{
-			return *MyBaseT::other();
+			return *MyGroupT::first();
 		}
 
 		ChildT*				first_child()
 		{
-			return MyBaseT::other();
+			return MyGroupT::first();
 		}
 
 		const ChildT*		first_child() const
 		{
-			return MyBaseT::other();
+			return MyGroupT::first();
 		}
 
 		ChildT*				last_child()
 		{
-			return MyBaseT::other();
+			return MyGroupT::last();
 		}
 
 		const ChildT*		last_child() const
 		{
-			return MyBaseT::other();
+			return MyGroupT::last();
 		}
 
-		ChildT*				previous_child(					MyLinkT&						child)
+		ChildT*				previous_child(				MyMemberT&						child)
 		{
-			return nullptr;
+			if(!child.is_member_of(*this)) return nullptr;
+			return child.previous();
 		}
-
-		const ChildT*		previous_child(					const MyLinkT&					CHILD) const
+			
+		const ChildT*		previous_child(				const MyMemberT&				CHILD) const
 		{
-			return nullptr;
+			if(!CHILD.is_member_of(*this)) return nullptr;
+			return CHILD.previous();
 		}
 
-		ChildT*				next_child(						MyLinkT&						child)
+		ChildT*				next_child(					MyMemberT&						child)
 		{
-			return nullptr;
+			if(!child.is_member_of(*this)) return nullptr;
+			return child.next();
 		}
 
-		const ChildT*		next_child(						const MyLinkT&					CHILD) const
+		const ChildT*		next_child(					const MyMemberT&				CHILD) const
 		{
-			return nullptr;
+			if(!CHILD.is_member_of(*this)) return nullptr;
+			return CHILD.next();
 		}
 
-		uint32_t			for_each_child(					const InvokeChild&				INVOKE_CHILD)
+		uint32_t			for_each_child(				const InvokeChild&				INVOKE_CHILD)
 		{
-			if(!has_child()) return 0;
-			INVOKE_CHILD(get_child());
-			return 1;
+			return MyGroupT::for_each_member(INVOKE_CHILD);
 		}
 
-		uint32_t			for_each_child(					const InvokeConstChild&			INVOKE_CHILD) const
+		uint32_t			for_each_child(				const InvokeConstChild&			INVOKE_CHILD) const
 		{
-			if(!has_child()) return 0;
-			INVOKE_CHILD(get_child());
-			return 1;
+			return MyGroupT::for_each_member(INVOKE_CHILD);
 		}
 
-		uint32_t			for_each_child_until(			const InvokeChildUntil&			INVOKE_CHILD)
+		uint32_t			for_each_child_until(		const InvokeChildUntil&			INVOKE_CHILD)
 		{
-			return ParentBase::for_each_child([&](ChildT& child){ INVOKE_CHILD(child); });
+			return MyGroupT::for_each_member_until(INVOKE_CHILD);
 		}
 
-		uint32_t			for_each_child_until(			const InvokeConstChildUntil&	INVOKE_CHILD) const
+		uint32_t			for_each_child_until(		const InvokeConstChildUntil&	INVOKE_CHILD) const
 		{
-			return ParentBase::for_each_child([&](const ChildT& CHILD){ INVOKE_CHILD(CHILD); });
+			return MyGroupT::for_each_member_until(INVOKE_CHILD);
 		}
 
-		void				save_children(					BinaryState&					state) const
+		void				detach_children()
 		{
-			Reference::save_to_binary_opt(first_child(), state);
+			while(ChildBaseT* child = first_child())
+			{
+				child->detach();
+			}
 		}
 
-		void				load_children(					BinaryState&					state)
+		void				save_children(				BinaryState&					state) const
 		{
-			MyBaseT::unlink();
-			const Reference REFERENCE(state);
-			if(ChildBaseT* child = REFERENCE.find<ChildT>())
+			state.save<uint32_t>(numChildren());
+			ParentBase::for_each_child([&](const ChildT& CHILD)
 			{
-				MyBaseT::link(*child);
-			}
-			else // log error
+				Reference::save_to_binary_opt(CHILD, state);
+			});
+		}
+
+		void				load_children(				BinaryState&					state)
+		{
+			detach_children();
+			Reference reference;
+			const uint32_t	NUM_CHILDREN = state.load<uint32_t>();
+			for(uint32_t index = 0; index < NUM_CHILDREN; ++index)
 			{
-				dpl::Logger::ref().push_error("Fail to import relation. The specified child could not be found: " + REFERENCE.name());
+				reference.load_from_binary(state);
+
+				if(ChildBaseT* child = reference.find<ChildT>())
+				{
+					MyGroupT::add_end_member(*child);
+				}
+				else //log error
+				{
+					dpl::Logger::ref().push_error("Fail to import relation. The specified child could not be found: " + reference.name());
+				}
 			}
 		}
 	};
 
 
-	template<typename ParentT, typename ChildT>
-	class	ParentBase<ParentT, ChildT, RelationType::ONE_TO_MANY> 
-		: private dpl::Group<ParentT, ChildT, dpl::get_relation_ID<ParentT, ChildT>()>
+	/*
+		Parent of the ONE_TO_MANY relation with contiguous storage, or the ONE_TO_SPECIFIC_NUMBER relation.
+		Children are not stored by index, because the index of the child changes whenever its pack is reordered, so it would have to be patched too.
+	*/
+	template<typename ParentT, typename ChildT, RelationType TYPE>
+	class	ParentBase<ParentT, ChildT, TYPE, RelationStorage::CONTIGUOUS_STORAGE> 
+		: private dpl::DenseGroup<ParentT, ChildT, dpl::get_relation_ID<ParentT, ChildT>(), dpl::get_max_children(TYPE)>
 	{
 	private: // subtypes
 		static const uint32_t RELATION_ID	= dpl::get_relation_ID<ParentT, ChildT>();
-		using	ChildBaseT					= ChildBase<ParentT, ChildT, RelationType::ONE_TO_MANY>;
-		using	MyMemberT					= dpl::Member<ParentT, ChildT, RELATION_ID>;
-		using	MyGroupT					= dpl::Group<ParentT, ChildT, RELATION_ID>;
+		static const uint32_t MAX_CHILDREN	= dpl::get_max_children(TYPE);
+		using	ChildBaseT					= ChildBase<ParentT, ChildT, TYPE, RelationStorage::CONTIGUOUS_STORAGE>;
+		using	MyMemberT					= dpl::DenseMember<ParentT, ChildT, RELATION_ID, MAX_CHILDREN>;
+		using	MyGroupT					= dpl::DenseGroup<ParentT, ChildT, RELATION_ID, MAX_CHILDREN>;
 
 	public: // subtypes
 		using	InvokeChild					= std::function<void(ChildT&)>;
@@ -1836,7 +2810,7 @@ namespace dpl
 
 		bool				can_have_another_child() const
 		{
-			return true;
+			return !MyGroupT::full();
 		}
 
 		uint32_t			numChildren() const
@@ -1846,12 +2820,6 @@ namespace dpl
 			
 		bool				add_child(					ChildT&							child)
 		{
-			/*
-			if (ChildFilter<ParentT, ChildT>()(static_cast<const ParentT&>(*this), child))
-			{
-				// TODO: add member here
-			}
-			*/
 			return MyGroupT::add_end_member(child);
 		}
 
@@ -1867,11 +2835,12 @@ namespace dpl
 
 		void				destroy_all_children()
 		{
-			ParentBase::for_each_child([](ChildT& child) 
+			EntityPack::DestructionBatch batch;
+			ParentBase::for_each_child([&](const ChildT& CHILD) 
 			{
-				Entity<ChildT>& entity = child;
-								entity.selfdestruct();
+				batch.add_hierarchy(CHILD);
 			});
+			batch.destroy();
 		}
 
 		ChildT&				get_child()
@@ -1884,6 +2853,26 @@ namespace dpl
 			return *MyGroupT::first();
 		}
 
+		ChildT&				child_at(					const uint32_t					INDEX)
+		{
+			return MyGroupT::member_at(INDEX);
+		}
+
+		const ChildT&		child_at(					const uint32_t					INDEX) const
+		{
+			return MyGroupT::member_at(INDEX);
+		}
+
+		std::span<ChildT* const>		children()
+		{
+			return MyGroupT::members();
+		}
+
+		std::span<const ChildT* const>	children() const
+		{
+			return MyGroupT::members();
+		}
+
 		ChildT*				first_child()
 		{
 			return MyGroupT::first();
@@ -1948,14 +2937,6 @@ namespace dpl
 			return MyGroupT::for_each_member_until(INVOKE_CHILD);
 		}
 
-		void				detach_children()
-		{
-			while(ChildBaseT* child = first_child())
-			{
-				child->detach();
-			}
-		}
-
 		void				save_children(				BinaryState&					state) const
 		{
 			state.save<uint32_t>(numChildren());
@@ -1967,7 +2948,7 @@ namespace dpl
 
 		void				load_children(				BinaryState&					state)
 		{
-			detach_children();
+			MyGroupT::remove_all_members();
 			Reference reference;
 			const uint32_t	NUM_CHILDREN = state.load<uint32_t>();
 			for(uint32_t index = 0; index < NUM_CHILDREN; ++index)
@@ -1976,7 +2957,8 @@ namespace dpl
 
 				if(ChildBaseT* child = reference.find<ChildT>())
 				{
-					MyGroupT::add_end_member(*child);
+					if(!MyGroupT::add_end_member(*child))
+						dpl::Logger::ref().push_error("Fail to import relation. The parent cannot have more children: " + reference.name());
 				}
 				else //log error
 				{
@@ -2016,7 +2998,7 @@ namespace dpl
 		friend	EntityManager;
 		friend	EntityPack_of<ParentT>;
 
-		template<typename, typename, RelationType>
+		template<typename, typename, RelationType, RelationStorage>
 		friend	class ChildBase;
 
 	protected:	// [LIFECYCLE]
@@ -2064,6 +3046,32 @@ namespace dpl
 			return ParentBase_of<ChildT>::get_child();
 		}
 
+		// Returns child at the given index (contiguous storage only).
+		template<dpl::is_one_of<CHILD_TYPES> ChildT>
+		ChildT&					child_at(					const uint32_t					INDEX)
+		{
+			return ParentBase_of<ChildT>::child_at(INDEX);
+		}
+
+		template<dpl::is_one_of<CHILD_TYPES> ChildT>
+		const ChildT&			child_at(					const uint32_t					INDEX) const
+		{
+			return ParentBase_of<ChildT>::child_at(INDEX);
+		}
+
+		// Returns all children of the given type (contiguous storage only).
+		template<dpl::is_one_of<CHILD_TYPES> ChildT>
+		std::span<ChildT* const>		children()
+		{
+			return ParentBase_of<ChildT>::children();
+		}
+
+		template<dpl::is_one_of<CHILD_TYPES> ChildT>
+		std::span<const ChildT* const>	children() const
+		{
+			return ParentBase_of<ChildT>::children();
+		}
+
 		template<dpl::is_one_of<CHILD_TYPES> ChildT>
 		ChildT*					first_child()
 		{
@@ -2140,25 +3148,32 @@ namespace dpl
 		template<is_one_of_base_types<CHILD_TYPES>	ChildT>
 		bool					add_child(					ChildT&							child)
 		{
-			return ParentBase_of<Base_in_list<ChildT, CHILD_TYPES>>::add_child(child);
+			if(!ParentBase_of<Base_in_list<ChildT, CHILD_TYPES>>::add_child(child)) return false;
+			EntityManager::notify_hierarchy_changed<ParentT, ChildT>();
+			return true;
 		}
 
 		template<is_one_of_base_types<CHILD_TYPES>	ChildT>
 		bool					remove_child(				ChildT&							child)
 		{
-			return ParentBase_of<Base_in_list<ChildT, CHILD_TYPES>>::remove_child(child);
+			if(!ParentBase_of<Base_in_list<ChildT, CHILD_TYPES>>::remove_child(child)) return false;
+			EntityManager::notify_hierarchy_changed<ParentT, ChildT>();
+			return true;
 		}
 
 		template<dpl::is_one_of<CHILD_TYPES> ChildT>
 		bool					remove_children_of_type()
 		{
-			return ParentBase_of<ChildT>::remove_all_children();
+			if(!ParentBase_of<ChildT>::remove_all_children()) return false;
+			EntityManager::notify_hierarchy_changed<ParentT, ChildT>();
+			return true;
 		}
 
 		template<dpl::is_same_as<ParentT>		This = ParentT>
 		void					remove_all_children_of_this()
 		{
 			(ParentBase_of<ChildTn>::remove_all_children(), ...);
+			EntityManager::notify_hierarchy_changed<ParentT, ChildTn...>();
 		}
 
 		template<dpl::is_one_of<CHILD_TYPES> ChildT>
@@ -2190,6 +3205,7 @@ namespace dpl
 		{
 			MyPartnerBase::load_relation_hierarchy(state);
 			Parent::load_children_of_this(state);
+			EntityManager::notify_hierarchy_changed<ParentT, ChildTn...>();
 		}
 	};
 
@@ -2224,16 +3240,69 @@ namespace dpl
 		void					load_relation_hierarchy(	BinaryState&				state)
 		{
 			MyPartnerBase::load_relation_hierarchy(state);
+			EntityManager::notify_hierarchy_changed<ParentT>();
 		}
 	};
 }
 
+// entity fork				(internal)
+namespace dpl
+{
+	template<is_Entity EntityT>
+	void	EntityManager::fork_relations_of(	const EntityT&		SOURCE,
+												EntityT&			clone,
+												const EntityRemap&	REMAP)
+	{
+		using	MyParent	= Parent<EntityT, ChildList_of<EntityT>>;
+		using	MyPartner	= Partner<EntityT, PartnerList_of<EntityT>>;
+
+		if constexpr (ChildList_of<EntityT>::SIZE > 0)
+		{
+			const MyParent&		SOURCE_PARENT	= SOURCE;
+			MyParent&			cloneParent		= clone;
+			std::invoke([&]<typename... ChildTs>(dpl::TypeList<ChildTs...> DUMMY)
+			{
+				(..., SOURCE_PARENT.template for_each_child<ChildTs>([&](const ChildTs& CHILD)
+				{
+					cloneParent.add_child(EntityManager::remap_or_throw(&CHILD, REMAP));
+				}));
+
+			}, ChildList_of<EntityT>());
+		}
+
+		if constexpr (PartnerList_of<EntityT>::SIZE > 0)
+		{
+			const MyPartner&	SOURCE_PARTNER	= SOURCE;
+			MyPartner&			clonePartner	= clone;
+			std::invoke([&]<typename... PartnerTs>(dpl::TypeList<PartnerTs...> DUMMY)
+			{
+				(..., std::invoke([&](Tag<PartnerTs> DUMMY)
+				{
+					if(!SOURCE_PARTNER.template has_partner<PartnerTs>()) return;
+					if(clonePartner.template has_partner<PartnerTs>()) return; //<-- Linked from the other side.
+					clonePartner.set_partner(EntityManager::remap_or_throw(&SOURCE_PARTNER.template get_partner<PartnerTs>(), REMAP));
+
+				}, Tag<PartnerTs>()));
+
+			}, PartnerList_of<EntityT>());
+		}
+
+		if constexpr (has_Base<EntityT>) EntityManager::fork_relations_of<Base_of<EntityT>>(SOURCE, clone, REMAP);
+	}
+}
+
 // maybe composite			(internal)
 namespace dpl
 {
 	template<typename EntityT>
 	concept is_Composite = (AllComponentTypes_of<EntityT>::SIZE > 0);
 
+	template<typename EntityT>
+	concept is_Tagged = (AllTagTypes_of<EntityT>::SIZE > 0);
+
+	template<typename EntityT>
+	concept has_SparseComponents = (AllSparseTypes_of<EntityT>::SIZE > 0);
+
 
 	template<typename EntityT, is_ComponentTypeList COMPONENT_TYPES>
 	class	MaybeComposite;
@@ -2283,14 +3352,14 @@ namespace dpl
 		T&				get_component()
 		{
 			MyPack& pack = MyPack::ref();
-			return *pack.row<T>().at(get_index(pack));
+			return *pack.template row<T>().at(get_index(pack));
 		}
 
 		template<dpl::is_one_of<COMPONENT_TYPES> T>
 		const T&		get_component() const
 		{
 			const MyPack& PACK = MyPack::ref();
-			return *PACK.row<T>().at(get_index(PACK));
+			return *PACK.template row<T>().at(get_index(PACK));
 		}
 
 		Column			get_all_components()
@@ -2364,8 +3433,9 @@ namespace dpl
 	* ChildTypes - types of entities assigned as a "child node"
 	* PartnerTypes - types of entities paired to this one (no special relation)
 	* ComponentTypes - List of data types assigned to this entity
+	* TagTypes - (optional) List of empty types marked per entity with a single bit
 	* NOTES: 
-	*	- your specialization must contain BaseType and the same type list names, any other typedef, or data will be ignored
+	*	- your specialization must contain BaseType and the same type list names (except of the optional ones), any other typedef, or data will be ignored
 	*	- all types specified by the base entity are used under the hood by all entity types that derive from it
 	*	- all types must be unique (double check types in the base class description)
 	*/
@@ -2411,12 +3481,18 @@ namespace dpl
 		- Specialization of Relation_between<ParentT, ChildT> further modifies internal structure and behavior of the Entity<EntityT>.
 		- The derived entity inherits relations defined by its base entity.
 		- The order of linked children is undefined.
+		- Children of the ONE_TO_MANY relation with CONTIGUOUS_STORAGE can be accessed by index (see Parent::child_at and Parent::children).
+		- Contiguous children are stored by address like any other relation: relocated child patches its own slot, relocated parent patches every child.
+		- Children of the ONE_TO_SPECIFIC_NUMBER<N> relation are stored inline in the parent, adding a child to the full parent fails.
 
 		[COMPOSITION]:
 		- A separate, contiguous buffer is allocated to store each type of component.
 		- Linking the buffer that stores a component type to the Stream object is possible if the component type satisfies the requirements for streamable data.
 		- The component types specified in the entity description are combined with those inherited from the Base.
 		- To meet the requirement, non-trivially destructible components must have operator>>(std::ostream&) and operator<<(std::istream&) implemented.
+		- Tag types (TagTypes of the description) are not stored in buffers, instead the pack stores one bit per entity for each tag type (see@ Entity::has_tag and EntityPack_of::for_each_tagged).
+		- Empty types listed in ComponentTypes remain regular components.
+		- Component types marked with SparseStorage_of are stored only for entities that were given one (see@ Entity::add_component and EntityPack_of::for_each_owner).
 	*/
 	template<typename EntityT>
 	class	Entity : public MaybeComposite<EntityT, AllComponentTypes_of<EntityT>>
@@ -2447,6 +3523,57 @@ namespace dpl
 			return MyComposition::storageID() == EntityPack_of<EntityT>::ref().typeID();
 		}
 
+		template<dpl::is_one_of<AllTagTypes_of<EntityT>> T>
+		bool					has_tag() const
+		{
+			const EntityPack_of<EntityT>& PACK = EntityPack_of<EntityT>::ref();
+			return PACK.template has_tag_at<T>(get_column(PACK));
+		}
+
+		template<dpl::is_one_of<AllTagTypes_of<EntityT>> T>
+		void					set_tag(	const bool		bVALUE = true)
+		{
+			EntityPack_of<EntityT>& pack = EntityPack_of<EntityT>::ref();
+			pack.template set_tag_at<T>(get_column(pack), bVALUE);
+		}
+
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		bool					has_component() const
+		{
+			const EntityPack_of<EntityT>& PACK = EntityPack_of<EntityT>::ref();
+			return PACK.template sparse_row<T>().has(get_column(PACK));
+		}
+
+		// Returns nullptr if entity has no such component.
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		T*						find_component()
+		{
+			EntityPack_of<EntityT>& pack = EntityPack_of<EntityT>::ref();
+			return pack.template sparse_row<T>().at(get_column(pack));
+		}
+
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		const T*				find_component() const
+		{
+			const EntityPack_of<EntityT>& PACK = EntityPack_of<EntityT>::ref();
+			return PACK.template sparse_row<T>().at(get_column(PACK));
+		}
+
+		// Returns existing component if entity already has one.
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		T&						add_component()
+		{
+			EntityPack_of<EntityT>& pack = EntityPack_of<EntityT>::ref();
+			return pack.template add_sparse_at<T>(get_column(pack));
+		}
+
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		bool					remove_component()
+		{
+			EntityPack_of<EntityT>& pack = EntityPack_of<EntityT>::ref();
+			return pack.template remove_sparse_at<T>(get_column(pack));
+		}
+
 		// Use with caution! (TODO: hide from the user?)
 		void					selfdestruct()
 		{
@@ -2492,6 +3619,12 @@ namespace dpl
 			if constexpr (has_Base<EntityT>) Entity<Base_of<EntityT>>::load(state);
 			static_cast<EntityT&>(*this).load_state(state);
 		}
+
+		uint32_t				get_column(	const EntityPack_of<EntityT>&	PACK) const
+		{
+			if(!has_known_storage()) throw dpl::GeneralException(this, __LINE__, "Tags and sparse components must be accessed through final entity class.");
+			return PACK.index_of(static_cast<const EntityT*>(this));
+		}
 	};
 
 
@@ -2536,28 +3669,23 @@ namespace dpl
 			}
 		}
 
-	private:	// [FUNCTIONS]
-		template<typename BaseEntityT>
-		void			call_recursively_for(const std::function<void(EntityPackView<BaseEntityT>&)>& INVOKE)
-		{
-			INVOKE(EntityPackView<BaseEntityT>(static_cast<EntityPack_of<EntityT>&>(*this)));
-
-			MyGroupT::for_each([&](EntityStorageNode<EntityT>& node)
-			{
-				node.call_recursively_for<BaseEntityT>(INVOKE);
-			});
-		}
 	};
 
 
 	template<typename EntityT>
 	using	MaybeComponentTable	= std::conditional_t<is_Composite<EntityT>, ComponentTable<EntityT, AllComponentTypes_of<EntityT>>, Monostate_t<EntityT, 2>>;
 
+	template<typename EntityT>
+	using	MaybeTagTable		= std::conditional_t<is_Tagged<EntityT>, TagTable<EntityT, AllTagTypes_of<EntityT>>, Monostate_t<EntityT, 3>>;
+
+	template<typename EntityT>
+	using	MaybeSparseTable	= std::conditional_t<has_SparseComponents<EntityT>, SparseTable<EntityT, AllSparseTypes_of<EntityT>>, Monostate_t<EntityT, 4>>;
+
 
 	/*
 		[DATA]:			EntityT
 		[STORAGE]:		contiguous
-		[ORDER]:		undefined
+		[ORDER]:		undefined (active entities are stored before inactive ones)
 		[INSERTION]:	fast
 		[ERASURE]:		fast
 	*/
@@ -2565,13 +3693,35 @@ namespace dpl
 	class	EntityPack_of	final	: public EntityPack
 									, public dpl::Singleton<EntityPack_of<EntityT>>
 									, public MaybeComponentTable<EntityT>
+									, public MaybeTagTable<EntityT>
+									, public MaybeSparseTable<EntityT>
 									, public EntityStorageNode<EntityT>
 	{
 	private:	// [SUBTYPES]
 		using	MySingletonBase		= dpl::Singleton<EntityPack_of<EntityT>>;
 		using	MyComponentTable	= MaybeComponentTable<EntityT>;
+		using	MyTagTable			= MaybeTagTable<EntityT>;
+		using	MySparseTable		= MaybeSparseTable<EntityT>;
 		using	MyNodeBase			= EntityStorageNode<EntityT>;
 
+		// Pack of this type or of any type derived from it (see@ register_similar_pack).
+		struct	SimilarPack
+		{
+			EntityPack*					pack;
+			EntityPackView<EntityT>		(*view_of)(EntityPack&); //<-- Views entities of the derived pack as EntityT.
+		};
+
+		// Non-empty views of this pack and packs of the derived types, built for a single iteration (see@ flatten_similar_packs).
+		struct	SimilarViews
+		{
+			std::vector<EntityPackView<EntityT>>	views;
+			std::vector<uint32_t>					offsets; //<-- Index of the first entity of each view in the flattened range.
+			uint32_t								numEntities = 0;
+#ifdef _DEBUG
+			std::deque<ScopedRead>					reads; //<-- Declared on the pack of each view until the iteration ends.
+#endif // _DEBUG
+		};
+
 	public:		// [FRIENDS]
 		friend	EntityManager;
 		friend  Entity<EntityT>;
@@ -2580,35 +3730,84 @@ namespace dpl
 		template<typename>
 		friend class EntityPack_of;
 
+		template<typename>
+		friend class EntityPackView;
+
+	public:		// [CONSTANTS]
+		static constexpr uint32_t CREATE_HISTORY = 8; //<-- Number of recent frames used to predict how many entities will be created in the next one.
+
 	public:		// [DATA]
 		dpl::ReadOnly<uint32_t, EntityPack_of>	typeID;
 
 	private:	// [DATA]
 		dpl::Labeler<char>						m_labeler;
 		std::vector<EntityT>					m_entities;
+		uint32_t								m_numActive; //<-- Entities in range [0, m_numActive) are active.
+		uint32_t								m_numCreated; //<-- Churn counters, reset by the collect_stats.
+		uint32_t								m_numDestroyed;
+		uint32_t								m_numRelocations;
+		std::array<uint32_t, CREATE_HISTORY>	m_createHistory; //<-- Number of entities created in each of the recent frames (ring buffer).
+		uint32_t								m_historyIndex;
+		uint32_t								m_numCreatedInFrame;
+		NO_UNIQUE_ADDRESS AccessTracker		m_access; //<-- Structure of the pack(creation, destruction, order), empty in release builds.
+		std::vector<SimilarPack>				m_similarPacks; //<-- This pack and packs of all derived types, changed only when the derived pack is created or destroyed.
 
 	public:		// [LIFECYCLE]
 		CLASS_CTOR					EntityPack_of(				const Binding&										BINDING)
 			: EntityPack(BINDING)
 			, MySingletonBase(static_cast<EntityManager*>(BINDING.owner())->owner())
 			, typeID(EntityPack::get_typeID<EntityPack_of<EntityT>>())
+			, m_numActive(0)
+			, m_numCreated(0)
+			, m_numDestroyed(0)
+			, m_numRelocations(0)
+			, m_historyIndex(0)
+			, m_numCreatedInFrame(0)
+		{
+			m_createHistory.fill(0);
+			EntityPack_of::register_similar_pack(*this);
+			if constexpr (has_Base<EntityT>)
+			{
+				m_basePack = &EntityPack_of<Base_of<EntityT>>::ref();
+				EntityPack_of::register_in_base_packs<Base_of<EntityT>>();
+			}
+		}
+
+		CLASS_DTOR					~EntityPack_of()
 		{
-			
+			if constexpr (has_Base<EntityT>)
+			{
+				dpl::no_except([&](){	EntityPack_of::unregister_from_base_packs<Base_of<EntityT>>();	});
+			}
 		}
 
 	public:		// [BASIC]
 		void						reserve_additional_space(	const uint32_t										AMOUNT)
 		{
-			const uint32_t NEW_CAPACITY = m_entities.size() + AMOUNT;
+			const ScopedWrite ACCESS(m_access, "EntityPack_of::reserve_additional_space");
+			const uint32_t	NEW_CAPACITY	= m_entities.size() + AMOUNT;
+			const bool		RELOCATION		= NEW_CAPACITY > m_entities.capacity();
 			m_labeler.reserve(NEW_CAPACITY);
 			m_entities.reserve(NEW_CAPACITY);
-			// NOTE: Component buffers are self regulated.
+			if constexpr (is_Composite<EntityT>) MyComponentTable::reserve_columns(NEW_CAPACITY);
+			if constexpr (is_Tagged<EntityT>) MyTagTable::reserve_tag_columns(NEW_CAPACITY);
+			if constexpr (has_SparseComponents<EntityT>) MySparseTable::reserve_sparse_columns(NEW_CAPACITY);
+			if(RELOCATION) EntityPack_of::notify_relocated();
 		}
 
 		EntityT&					create(						const Name&											ENTITY_NAME)
 		{
+			const ScopedWrite ACCESS(m_access, "EntityPack_of::create");
+			const bool RELOCATION = m_entities.size() == m_entities.capacity();
 			if constexpr (is_Composite<EntityT>) MyComponentTable::add_column();
-			return m_entities.emplace_back(Origin(ENTITY_NAME, typeID(), m_labeler));
+			if constexpr (is_Tagged<EntityT>) MyTagTable::add_tag_columns(1);
+			if constexpr (has_SparseComponents<EntityT>) MySparseTable::add_sparse_columns(1);
+			m_entities.emplace_back(Origin(ENTITY_NAME, typeID(), m_labeler));
+			if(RELOCATION) EntityPack_of::notify_relocated();
+			EntityPack_of::swap_entities(m_numActive, size()-1); //<-- New entity is active.
+			++m_numCreated;
+			++m_numCreatedInFrame;
+			return m_entities[m_numActive++];
 		}
 
 		EntityT&					create(						const Name::Type&									NAME_TYPE,
@@ -2617,36 +3816,12 @@ namespace dpl
 			return create(Name(NAME_TYPE, NAME));
 		}
 
-		bool						destroy_at(					uint64_t											index)
+		bool						destroy_at(					const uint64_t										INDEX)
 		{
-			if(index >= m_entities.size()) return false;
-			std::invoke([&]<typename... ChildTs>(dpl::TypeList<ChildTs...> DUMMY)
-			{
-				(..., std::invoke([&](Tag<ChildTs> DUMMY)
-				{
-					if constexpr (dpl::are_strongly_dependant<EntityT, ChildTs>())
-					{
-						while(ChildTs* child = m_entities[index].last_child<ChildTs>())
-						{
-							if constexpr (std::is_same_v<EntityT, ChildTs>)
-							{
-								if(index+1 == m_entities.size())
-								{
-									// Parent will be swapped with the child (fast erase), we have to correct the index.
-									index = dpl::get_element_index(m_entities, child);
-								}
-							}
-
-							static_cast<Entity<ChildTs>*>(child)->selfdestruct();
-						}
-					}
-
-				}, Tag<ChildTs>()));
-
-			}, AllChildTypes_of<EntityT>());
-			
-			dpl::fast_remove(m_entities, m_entities.begin() + index);
-			if constexpr (is_Composite<EntityT>) MyComponentTable::remove_column((uint32_t)index);
+			if(INDEX >= m_entities.size()) return false;
+			EntityPack::DestructionBatch batch;
+			batch.add_hierarchy(*this, (uint32_t)INDEX, m_entities[INDEX]);
+			batch.destroy();
 			return true;
 		}
 
@@ -2662,22 +3837,70 @@ namespace dpl
 			return EntityPack_of::destroy(*ENTITY);
 		}
 
+		/*
+			Moves entity across the boundary between active and inactive entities (changes its index).
+			Inactive entities keep their names, components and relations, but are skipped by for_each functions.
+			Returns false if entity is not stored in this pack, or it is already in the given state.
+		*/
+		bool						set_active(					const EntityT&										ENTITY,
+																const bool											ACTIVE)
+		{
+			const ScopedWrite ACCESS(m_access, "EntityPack_of::set_active");
+			const uint32_t INDEX = index_of(&ENTITY);
+			if(!contains(INDEX) || is_active_at(INDEX) == ACTIVE) return false;
+			if(ACTIVE)	EntityPack_of::swap_entities(INDEX, m_numActive++);
+			else		EntityPack_of::swap_entities(INDEX, --m_numActive);
+			return true;
+		}
+
 		bool						destroy_all()
 		{
 			if (size() == 0) return false;
-			while (size() > 0)
+			EntityPack::DestructionBatch batch;
+			for(uint32_t entityID = 0; entityID < size(); ++entityID)
 			{
-				destroy_at(size()-1);
+				batch.add_hierarchy(*this, entityID, m_entities[entityID]);
 			}
+			batch.destroy();
 			return true;
 		}
 
+	public:		// [ACCESS] (checked in debug builds only)
+		/*
+			Declares that the structure of the pack(entities, their order and number) is read or modified in the current scope.
+			Creation, destruction, activation and parallel iteration declare it implicitly.
+		*/
+		ScopedRead					scoped_read(				const char*											LABEL = nullptr) const
+		{
+			return ScopedRead(m_access, LABEL);
+		}
+
+		ScopedWrite					scoped_write(				const char*											LABEL = nullptr)
+		{
+			return ScopedWrite(m_access, LABEL);
+		}
+
 	public:		// [QUERY]
 		uint32_t					size() const
 		{
 			return (uint32_t)m_entities.size();
 		}
 
+		uint32_t					numActive() const
+		{
+			return m_numActive;
+		}
+
+		bool						is_active_at(				const uint32_t										ENTITY_INDEX) const
+		{
+			return ENTITY_INDEX < m_numActive;
+		}
+
+		bool						is_active(					const EntityT&										ENTITY) const
+		{
+			return is_active_at(index_of(&ENTITY));
+		}
+
 		uint32_t					index_of(					const EntityT*										ENTITY) const
 		{
 			const uint64_t INDEX64 = dpl::get_element_index(m_entities, ENTITY);
@@ -2746,7 +3969,17 @@ namespace dpl
 			return m_entities.back();
 		}
 
-		uint32_t					guess_ID_from_byte(			const char*											ENTITY_MEMBER_PTR) const
+		EntityT&					last_active()
+		{
+			return m_entities[m_numActive-1];
+		}
+
+		const EntityT&				last_active() const
+		{
+			return m_entities[m_numActive-1];
+		}
+
+		virtual uint32_t			guess_ID_from_byte(			const char*											ENTITY_MEMBER_PTR) const final override
 		{
 			static const uint64_t	STRIDE			= sizeof(EntityT);
 			const char*				BEGIN			= reinterpret_cast<const char*>(m_entities.data());
@@ -2754,7 +3987,7 @@ namespace dpl
 			const uint64_t			BYTE_OFFSET		= ENTITY_MEMBER_PTR - BEGIN;
 			const char*				END				= BEGIN + TOTAL_NUM_BYTES;
 
-			if(ENTITY_MEMBER_PTR < BEGIN || ENTITY_MEMBER_PTR > END) return EntityPack::INVALID_ENTITY_ID;
+			if(ENTITY_MEMBER_PTR < BEGIN || ENTITY_MEMBER_PTR >= END) return EntityPack::INVALID_ENTITY_ID;
 			return (uint32_t)(BYTE_OFFSET / STRIDE);
 		}
 
@@ -2769,21 +4002,20 @@ namespace dpl
 			return false;
 		}
 
-	public:		// [ITERATION]
+	public:		// [ITERATION] (active entities only)
 		void						for_each(					const InvokeEntity<EntityT>&						INVOKE)
 		{
-			std::for_each(m_entities.begin(), m_entities.end(), INVOKE);
+			std::for_each(m_entities.begin(), m_entities.begin() + m_numActive, INVOKE);
 		}
 
 		void						for_each(					const InvokeConstEntity<EntityT>&					INVOKE) const
 		{
-			std::for_each(m_entities.begin(), m_entities.end(), INVOKE);
+			std::for_each(m_entities.begin(), m_entities.begin() + m_numActive, INVOKE);
 		}
 
 		void						for_each(					const InvokeIndexedEntity<EntityT>&					INVOKE)
 		{
-			const uint32_t SIZE = size();
-			for(uint32_t index = 0; index < SIZE; ++index)
+			for(uint32_t index = 0; index < m_numActive; ++index)
 			{
 				INVOKE(m_entities[index], index);
 			}
@@ -2791,8 +4023,7 @@ namespace dpl
 
 		void						for_each(					const InvokeConstIndexedEntity<EntityT>&			INVOKE)
 		{
-			const uint32_t SIZE = size();
-			for(uint32_t index = 0; index < SIZE; ++index)
+			for(uint32_t index = 0; index < m_numActive; ++index)
 			{
 				INVOKE(m_entities[index], index);
 			}
@@ -2800,106 +4031,145 @@ namespace dpl
 
 		void						for_each(					const InvokeEntityBuffer<EntityT>&					INVOKE)
 		{
-			INVOKE(m_entities.data(), size());
+			INVOKE(m_entities.data(), m_numActive);
 		}
 
 		void						for_each(					const InvokeConstEntityBuffer<EntityT>&				INVOKE) const
 		{
-			INVOKE(m_entities.data(), size());
+			INVOKE(m_entities.data(), m_numActive);
+		}
+
+		// Invokes function for each active entity that has all of the given tags (see@ TagTable::for_each_tagged_column).
+		template<dpl::is_one_of<AllTagTypes_of<EntityT>>... Ts> requires (sizeof...(Ts) > 0)
+		void						for_each_tagged(			const InvokeEntity<EntityT>&						INVOKE)
+		{
+			MyTagTable::template for_each_tagged_column<Ts...>(m_numActive, [&](const uint32_t INDEX)
+			{
+				INVOKE(m_entities[INDEX]);
+			});
+		}
+
+		template<dpl::is_one_of<AllTagTypes_of<EntityT>>... Ts> requires (sizeof...(Ts) > 0)
+		void						for_each_tagged(			const InvokeConstEntity<EntityT>&					INVOKE) const
+		{
+			MyTagTable::template for_each_tagged_column<Ts...>(m_numActive, [&](const uint32_t INDEX)
+			{
+				INVOKE(m_entities[INDEX]);
+			});
+		}
+
+		// Invokes function for each active entity that owns a sparse component of the given type (components must not be added or removed during iteration).
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		void						for_each_owner(				const std::function<void(EntityT&, T&)>&			INVOKE)
+		{
+			auto&			row		= MySparseTable::template sparse_row<T>();
+			const uint32_t*	OWNERS	= row.owners();
+			for(uint32_t index = 0; index < row.size(); ++index)
+			{
+				if(OWNERS[index] < m_numActive) INVOKE(m_entities[OWNERS[index]], row.data()[index]);
+			}
+		}
+
+		template<dpl::is_one_of<AllSparseTypes_of<EntityT>> T>
+		void						for_each_owner(				const std::function<void(const EntityT&, const T&)>&	INVOKE) const
+		{
+			const auto&		ROW		= MySparseTable::template sparse_row<T>();
+			const uint32_t*	OWNERS	= ROW.owners();
+			for(uint32_t index = 0; index < ROW.size(); ++index)
+			{
+				if(OWNERS[index] < m_numActive) INVOKE(m_entities[OWNERS[index]], ROW.data()[index]);
+			}
 		}
 
+		// Invokes view of this pack and each pack of the derived types.
 		void						for_each(					const InvokeSimilarEntityBuffer<EntityT>&			INVOKE)
 		{
-			MyNodeBase::call_recursively_for<EntityT>(INVOKE);
+			for(const SimilarPack& SIMILAR : m_similarPacks)
+			{
+				EntityPackView<EntityT> view = SIMILAR.view_of(*SIMILAR.pack);
+				INVOKE(view);
+			}
 		}
 
-	public:		// [PARALLEL ITERATION]
+	public:		// [PARALLEL ITERATION] (active entities only)
 		void						for_each_in_parallel(		dpl::ParallelPhase&									phase,
 																const InvokeEntity<EntityT>&						INVOKE)
 		{
-			dpl::IndexRange<>(0, size()).for_each_split(phase.numJobs(), [&](const auto RANGE_OF_ENTITIES)
+			const ScopedRead ACCESS(m_access, "EntityPack_of::for_each_in_parallel");
+			dpl::parallel_for(phase, dpl::IndexRange<>(0, m_numActive), [&](const dpl::IndexRange<>& RANGE_OF_ENTITIES)
 			{
-				phase.add_task(RANGE_OF_ENTITIES.size(), [&, RANGE_OF_ENTITIES]()
+				RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
 				{
-					RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
-					{
-						INVOKE(m_entities[INDEX]);
-					});
+					INVOKE(m_entities[INDEX]);
 				});
 			});
-		
-			phase.start();
 		}
 
 		void						for_each_in_parallel(		dpl::ParallelPhase&									phase,
 																const InvokeConstEntity<EntityT>&					INVOKE) const
 		{
-			dpl::IndexRange<>(0, size()).for_each_split(phase.numJobs(), [&](const auto RANGE_OF_ENTITIES)
+			const ScopedRead ACCESS(m_access, "EntityPack_of::for_each_in_parallel");
+			dpl::parallel_for(phase, dpl::IndexRange<>(0, m_numActive), [&](const dpl::IndexRange<>& RANGE_OF_ENTITIES)
 			{
-				phase.add_task(RANGE_OF_ENTITIES.size(), [&, RANGE_OF_ENTITIES]()
+				RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
 				{
-					RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
-					{
-						INVOKE(m_entities[INDEX]);
-					});
+					INVOKE(m_entities[INDEX]);
 				});
 			});
-		
-			phase.start();
 		}
 
 		void						for_each_in_parallel(		dpl::ParallelPhase&									phase,
 																const InvokeIndexedEntity<EntityT>&					INVOKE)
 		{
-			dpl::IndexRange<>(0, size()).for_each_split(phase.numJobs(), [&](const auto RANGE_OF_ENTITIES)
+			const ScopedRead ACCESS(m_access, "EntityPack_of::for_each_in_parallel");
+			dpl::parallel_for(phase, dpl::IndexRange<>(0, m_numActive), [&](const dpl::IndexRange<>& RANGE_OF_ENTITIES)
 			{
-				phase.add_task(RANGE_OF_ENTITIES.size(), [&, RANGE_OF_ENTITIES]()
+				RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
 				{
-					RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
-					{
-						INVOKE(m_entities[INDEX], INDEX);
-					});
+					INVOKE(m_entities[INDEX], INDEX);
 				});
 			});
-		
-			phase.start();
 		}
 
 		void						for_each_in_parallel(		dpl::ParallelPhase&									phase,
 																const InvokeConstIndexedEntity<EntityT>&			INVOKE)
 		{
-			dpl::IndexRange<>(0, size()).for_each_split(phase.numJobs(), [&](const auto RANGE_OF_ENTITIES)
+			const ScopedRead ACCESS(m_access, "EntityPack_of::for_each_in_parallel");
+			dpl::parallel_for(phase, dpl::IndexRange<>(0, m_numActive), [&](const dpl::IndexRange<>& RANGE_OF_ENTITIES)
 			{
-				phase.add_task(RANGE_OF_ENTITIES.size(), [&, RANGE_OF_ENTITIES]()
+				RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
 				{
-					RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
-					{
-						INVOKE(m_entities[INDEX], INDEX);
-					});
+					INVOKE(m_entities[INDEX], INDEX);
 				});
 			});
-		
-			phase.start();
 		}
 
+		// Entities of this pack and packs of the derived types are treated as a single range split between claimers of the phase.
 		void						for_each_in_parallel(		dpl::ParallelPhase&									phase,
 																const InvokeSimilarIndexedEntityBuffer<EntityT>&	INVOKE)
 		{
-			EntityPack_of::for_each([&](dpl::EntityPackView<EntityT>& view)
+			const ScopedRead ACCESS(m_access, "EntityPack_of::for_each_in_parallel");
+			const SimilarViews SIMILAR = EntityPack_of::flatten_similar_packs();
+
+			dpl::parallel_for(phase, dpl::IndexRange<>(0, SIMILAR.numEntities), [&](const dpl::IndexRange<>& RANGE_OF_ENTITIES)
 			{
-				dpl::IndexRange<>(0, view.numEntities()).for_each_split(phase.numJobs(), [&](const auto RANGE_OF_ENTITIES)
+				auto		offsetIt	= std::upper_bound(SIMILAR.offsets.begin(), SIMILAR.offsets.end(), RANGE_OF_ENTITIES.begin()) - 1;
+				uint32_t	viewIndex	= (uint32_t)std::distance(SIMILAR.offsets.begin(), offsetIt);
+				uint32_t	index		= RANGE_OF_ENTITIES.begin();
+
+				while(index < RANGE_OF_ENTITIES.end())
 				{
-					phase.add_task(RANGE_OF_ENTITIES.size(), [&, RANGE_OF_ENTITIES]()
+					const EntityPackView<EntityT>&	VIEW		= SIMILAR.views[viewIndex];
+					const uint32_t					OFFSET		= SIMILAR.offsets[viewIndex];
+					const uint32_t					VIEW_END	= std::min<uint32_t>(OFFSET + VIEW.numEntities(), RANGE_OF_ENTITIES.end());
+
+					for(; index < VIEW_END; ++index)
 					{
-						RANGE_OF_ENTITIES.for_each([&](const uint32_t INDEX)
-						{
-							INVOKE(view, INDEX);
-						});
-					});
-				});
+						INVOKE(VIEW, index - OFFSET);
+					}
+					++viewIndex;
+				}
 			});
-		
-			phase.start();
 		}
 	public:		// [IO]
 		void						save_entity(				const Entity<EntityT>&								ENTITY,
@@ -2910,6 +4180,8 @@ namespace dpl
 
 			ENTITY.save(state);
 			if constexpr(is_Composite<EntityT>) ENTITY.save_components_to_binary(state);
+			if constexpr(is_Tagged<EntityT>) EntityPack_of::save_tags_to_binary(index_of(static_cast<const EntityT*>(&ENTITY)), state);
+			if constexpr(has_SparseComponents<EntityT>) EntityPack_of::save_sparse_components_to_binary(index_of(static_cast<const EntityT*>(&ENTITY)), state);
 			ENTITY.save_relation_hierarchy(state);
 		}
 
@@ -2929,6 +4201,8 @@ namespace dpl
 
 			entity.load(state);
 			if constexpr(is_Composite<EntityT>) entity.load_components_from_binary(state);
+			if constexpr(is_Tagged<EntityT>) EntityPack_of::load_tags_from_binary(index_of(static_cast<const EntityT*>(&entity)), state);
+			if constexpr(has_SparseComponents<EntityT>) EntityPack_of::load_sparse_components_from_binary(index_of(static_cast<const EntityT*>(&entity)), state);
 			entity.load_relation_hierarchy(state);
 		}
 
@@ -2977,7 +4251,7 @@ namespace dpl
 				{
 					if(dpl::get_dependency_between<EntityT, ChildTs>() == DEPENDENCY)
 					{
-						ENTITY.for_each_child<ChildTs>([&](const ChildTs& CHILD)
+						ENTITY.template for_each_child<ChildTs>([&](const ChildTs& CHILD)
 						{
 							INVOKE(CHILD);
 						});
@@ -2988,6 +4262,132 @@ namespace dpl
 			}, AllChildTypes_of<EntityT>());
 		}
 
+	private:	// [INTERNAL FUNCTIONS]
+		void						swap_entities(				const uint32_t										FIRST_INDEX,
+																const uint32_t										SECOND_INDEX)
+		{
+			if(FIRST_INDEX == SECOND_INDEX) return;
+			std::swap(m_entities[FIRST_INDEX], m_entities[SECOND_INDEX]);
+			if constexpr (is_Composite<EntityT>) MyComponentTable::swap_columns(FIRST_INDEX, SECOND_INDEX);
+			if constexpr (is_Tagged<EntityT>) MyTagTable::swap_tag_columns(FIRST_INDEX, SECOND_INDEX);
+			if constexpr (has_SparseComponents<EntityT>) MySparseTable::swap_sparse_columns(FIRST_INDEX, SECOND_INDEX);
+			EntityPack::notify_hierarchy_changed();
+		}
+
+		void						save_tags_to_binary(		const uint32_t										ENTITY_ID,
+																BinaryState&										state) const
+		{
+			const MyTagTable& TABLE = *this;
+			std::invoke([&]<typename... TagTs>(dpl::TypeList<TagTs...> DUMMY)
+			{
+				(state.save(TABLE.template has_tag_at<TagTs>(ENTITY_ID)), ...);
+
+			}, AllTagTypes_of<EntityT>());
+		}
+
+		void						load_tags_from_binary(		const uint32_t										ENTITY_ID,
+																BinaryState&										state)
+		{
+			MyTagTable& table = *this;
+			std::invoke([&]<typename... TagTs>(dpl::TypeList<TagTs...> DUMMY)
+			{
+				bool bVALUE = false;
+				((state.load(bVALUE), table.template set_tag_at<TagTs>(ENTITY_ID, bVALUE)), ...);
+
+			}, AllTagTypes_of<EntityT>());
+		}
+
+		// Each sparse component is preceded by a flag that indicates its presence.
+		void						save_sparse_components_to_binary(	const uint32_t								ENTITY_ID,
+																		BinaryState&								state) const
+		{
+			const MySparseTable& TABLE = *this;
+			std::invoke([&]<typename... SparseTs>(dpl::TypeList<SparseTs...> DUMMY)
+			{
+				(std::invoke([&](const SparseTs* COMPONENT)
+				{
+					state.save(COMPONENT != nullptr);
+					if(COMPONENT) state.save(*COMPONENT);
+
+				}, TABLE.template sparse_row<SparseTs>().at(ENTITY_ID)), ...);
+
+			}, AllSparseTypes_of<EntityT>());
+		}
+
+		void						load_sparse_components_from_binary(	const uint32_t								ENTITY_ID,
+																		BinaryState&								state)
+		{
+			MySparseTable& table = *this;
+			std::invoke([&]<typename... SparseTs>(dpl::TypeList<SparseTs...> DUMMY)
+			{
+				bool bHAS_COMPONENT = false;
+				(..., (state.load(bHAS_COMPONENT), bHAS_COMPONENT	? state.load(table.template add_sparse_at<SparseTs>(ENTITY_ID))
+																	: (void)table.template remove_sparse_at<SparseTs>(ENTITY_ID)));
+
+			}, AllSparseTypes_of<EntityT>());
+		}
+
+		/*
+			Builds the views of the cached similar packs(see@ m_similarPacks) with prefix-summed sizes.
+			Views store addresses of the entity and component buffers, so they are built by each iteration and owned by it.
+			Read access to each viewed pack is declared until the views are destroyed (debug builds only).
+		*/
+		SimilarViews				flatten_similar_packs()
+		{
+			SimilarViews similar;
+			similar.views.reserve(m_similarPacks.size());
+			similar.offsets.reserve(m_similarPacks.size());
+			for(const SimilarPack& SIMILAR : m_similarPacks)
+			{
+				EntityPackView<EntityT> view = SIMILAR.view_of(*SIMILAR.pack);
+				if(view.numEntities() == 0) continue;
+#ifdef _DEBUG
+				similar.reads.emplace_back(*view.access, "EntityPack_of::for_each_in_parallel");
+#endif // _DEBUG
+				similar.offsets.push_back(similar.numEntities);
+				similar.numEntities += view.numEntities();
+				similar.views.push_back(view);
+			}
+			return similar;
+		}
+
+		// Adds the DERIVED pack to the similar packs of this type.
+		template<typename DerivedEntityT>
+		void						register_similar_pack(		EntityPack_of<DerivedEntityT>&						derived)
+		{
+			m_similarPacks.push_back({&derived, [](EntityPack& pack)
+			{
+				return EntityPackView<EntityT>(static_cast<EntityPack_of<DerivedEntityT>&>(pack));
+			}});
+		}
+
+		// This pack is added to the similar packs of the BaseT and each of its bases.
+		template<typename BaseT>
+		void						register_in_base_packs()
+		{
+			EntityPack_of<BaseT>::ref().register_similar_pack(*this);
+			if constexpr (has_Base<BaseT>) EntityPack_of::register_in_base_packs<Base_of<BaseT>>();
+		}
+
+		// Base packs that were already destroyed are skipped.
+		template<typename BaseT>
+		void						unregister_from_base_packs()
+		{
+			if(EntityPack_of<BaseT>* basePack = EntityPack_of<BaseT>::ptr())
+			{
+				std::erase_if(basePack->m_similarPacks, [&](const auto& SIMILAR){ return SIMILAR.pack == this; });
+			}
+			if constexpr (has_Base<BaseT>) EntityPack_of::unregister_from_base_packs<Base_of<BaseT>>();
+		}
+
+		void						notify_relocated()
+		{
+			++m_numRelocations;
+			const char* BEGIN = reinterpret_cast<const char*>(m_entities.data());
+			EntityPack::notify_hierarchy_changed();
+			EntityManager::ref().update_storage_range(*this, BEGIN, BEGIN + sizeof(EntityT) * m_entities.capacity());
+		}
+
 	private:	// [IMPLEMENTATION]
 		virtual bool				destroy_around(				const char*											ENTITY_MEMBER_BYTE_PTR) final override
 		{
@@ -3009,7 +4409,80 @@ namespace dpl
 
 		virtual void				destroy_all_entities() final override
 		{
+			if constexpr (is_Composite<EntityT>) MyComponentTable::remove_last_columns(size());
+			if constexpr (is_Tagged<EntityT>) MyTagTable::remove_last_tag_columns(size());
+			if constexpr (has_SparseComponents<EntityT>) MySparseTable::remove_last_sparse_columns(size());
+			m_numDestroyed += size();
 			m_entities.clear();
+			m_numActive = 0;
+		}
+
+		virtual void				collect_strong_dependants(	const uint32_t										ENTITY_ID,
+																DestructionBatch&									batch) final override
+		{
+			const EntityT& ENTITY = m_entities[ENTITY_ID];
+
+			std::invoke([&]<typename... ChildTs>(dpl::TypeList<ChildTs...> DUMMY)
+			{
+				(..., std::invoke([&](Tag<ChildTs> DUMMY)
+				{
+					if constexpr (dpl::are_strongly_dependant<EntityT, ChildTs>())
+					{
+						ENTITY.template for_each_child<ChildTs>([&](const ChildTs& CHILD)
+						{
+							EntityPack_of<ChildTs>& childPack = EntityPack_of<ChildTs>::ref();
+							if(CHILD.storageID() == childPack.typeID())
+							{
+								batch.add(childPack, childPack.index_of(&CHILD), CHILD);
+							}
+							else // Child is stored in the pack of the derived type.
+							{
+								batch.add(CHILD);
+							}
+						});
+					}
+
+				}, Tag<ChildTs>()));
+
+			}, AllChildTypes_of<EntityT>());
+		}
+
+		virtual void				destroy_batched(			const std::vector<uint32_t>&						SORTED_IDS) final override
+		{
+			const ScopedWrite ACCESS(m_access, "EntityPack_of::destroy");
+			EntityPack::notify_hierarchy_changed();
+
+			auto move_entity = [&](const uint32_t SOURCE, const uint32_t TARGET)
+			{
+				if(SOURCE == TARGET) return;
+				m_entities[TARGET] = std::move(m_entities[SOURCE]);
+				if constexpr (is_Composite<EntityT>) MyComponentTable::move_column(SOURCE, TARGET);
+				if constexpr (is_Tagged<EntityT>) MyTagTable::move_tag_column(SOURCE, TARGET);
+				if constexpr (has_SparseComponents<EntityT>) MySparseTable::move_sparse_column(SOURCE, TARGET);
+			};
+
+			// Descending order guarantees that entities moved from the end of each partition are never pending for removal.
+			uint32_t numAlive = size();
+			for(const uint32_t ENTITY_ID : SORTED_IDS)
+			{
+				--numAlive;
+				if(ENTITY_ID < m_numActive) //<-- Hole in the active partition is filled with the last active entity.
+				{
+					--m_numActive;
+					move_entity(m_numActive, ENTITY_ID);
+					move_entity(numAlive, m_numActive);
+				}
+				else
+				{
+					move_entity(numAlive, ENTITY_ID);
+				}
+			}
+
+			m_entities.erase(m_entities.begin() + numAlive, m_entities.end());
+			if constexpr (is_Composite<EntityT>) MyComponentTable::remove_last_columns((uint32_t)SORTED_IDS.size());
+			if constexpr (is_Tagged<EntityT>) MyTagTable::remove_last_tag_columns((uint32_t)SORTED_IDS.size());
+			if constexpr (has_SparseComponents<EntityT>) MySparseTable::remove_last_sparse_columns((uint32_t)SORTED_IDS.size());
+			m_numDestroyed += (uint32_t)SORTED_IDS.size();
 		}
 
 		virtual void				save_and_destroy(			const std::string&									ENTITY_NAME,
@@ -3023,6 +4496,131 @@ namespace dpl
 		{
 			EntityPack_of::load_entity(create(Name::UNIQUE, ENTITY_NAME), state);
 		}
+
+		virtual void				save_named_entity(			const std::string&									ENTITY_NAME,
+																BinaryState&										state) const final override
+		{
+			EntityPack_of::save_entity(ENTITY_NAME, state);
+		}
+
+		virtual void				create_named_entity(		const std::string&									ENTITY_NAME) final override
+		{
+			EntityPack_of::create(Name::UNIQUE, ENTITY_NAME);
+		}
+
+		virtual void				load_named_entity(			const std::string&									ENTITY_NAME,
+																BinaryState&										state) final override
+		{
+			EntityPack_of::load_entity(ENTITY_NAME, state);
+		}
+
+		virtual void				fork_entities_to(			EntityPack&											target) final override
+		{
+			EntityPack_of& clonePack = static_cast<EntityPack_of&>(target);
+			clonePack.reserve_additional_space(size());
+
+			BinaryState state; //<-- Carries only members of the EntityT (see@ Entity::save_state).
+			for(const Entity<EntityT>& ENTITY : m_entities)
+			{
+				Entity<EntityT>& clone = clonePack.create(Name(Name::UNIQUE, ENTITY.name()));
+				ENTITY.save(state);
+				clone.load(state);
+			}
+			clonePack.m_numActive = m_numActive;
+
+			if constexpr (is_Composite<EntityT>)
+			{
+				std::invoke([&]<typename... ComponentTs>(dpl::TypeList<ComponentTs...> DUMMY)
+				{
+					(..., this->template row<ComponentTs>().fork_to(clonePack.template row<ComponentTs>()));
+
+				}, AllComponentTypes_of<EntityT>());
+			}
+
+			if constexpr (is_Tagged<EntityT>) clonePack.copy_tag_columns(*this);
+			if constexpr (has_SparseComponents<EntityT>) clonePack.copy_sparse_columns(*this);
+		}
+
+		virtual void				fork_relations_to(			EntityPack&											target,
+																const EntityRemap&									REMAP) const final override
+		{
+			EntityPack_of& clonePack = static_cast<EntityPack_of&>(target);
+			for(uint32_t index = 0; index < size(); ++index)
+			{
+				EntityManager::fork_relations_of<EntityT>(m_entities[index], clonePack.m_entities[index], REMAP);
+			}
+		}
+
+		virtual void				collect_stats(				Stats&												stats) final override
+		{
+			stats.typeName				= get_entity_typeName();
+			stats.typeID				= typeID();
+			stats.numEntities			= size();
+			stats.numActive				= m_numActive;
+			stats.capacity				= (uint32_t)m_entities.capacity();
+			stats.entitySize			= sizeof(EntityT);
+			stats.numComponentRows		= (uint32_t)AllComponentTypes_of<EntityT>::SIZE;
+			stats.numTagRows			= (uint32_t)AllTagTypes_of<EntityT>::SIZE;
+			stats.numSparseRows			= (uint32_t)AllSparseTypes_of<EntityT>::SIZE;
+			stats.labelerLoadFactor		= m_labeler.get_loadFactor();
+			stats.labelerNumBuckets		= m_labeler.get_numBuckets();
+			stats.numParentTypes		= (uint32_t)AllParentTypes_of<EntityT>::SIZE;
+			stats.numChildTypes			= (uint32_t)AllChildTypes_of<EntityT>::SIZE;
+			stats.numPartnerTypes		= (uint32_t)AllPartnerTypes_of<EntityT>::SIZE;
+			stats.numCreated			= m_numCreated;
+			stats.numDestroyed			= m_numDestroyed;
+			stats.numRelocations		= m_numRelocations;
+
+			if constexpr (is_Composite<EntityT>)
+			{
+				std::invoke([&]<typename... ComponentTs>(dpl::TypeList<ComponentTs...> DUMMY)
+				{
+					stats.componentSize		= (0 + ... + sizeof(ComponentTs));
+					stats.componentRowBytes	= (0 + ... + ((uint64_t)sizeof(ComponentTs) * this->template row<ComponentTs>().capacity()));
+
+				}, AllComponentTypes_of<EntityT>());
+			}
+
+			if constexpr (has_SparseComponents<EntityT>)
+			{
+				std::invoke([&]<typename... SparseTs>(dpl::TypeList<SparseTs...> DUMMY)
+				{
+					stats.numSparseComponents = (0 + ... + this->template sparse_row<SparseTs>().size());
+
+				}, AllSparseTypes_of<EntityT>());
+			}
+
+			std::invoke([&]<typename... ChildTs>(dpl::TypeList<ChildTs...> DUMMY)
+			{
+				for(const EntityT& ENTITY : m_entities)
+				{
+					stats.numChildren += (0 + ... + ENTITY.template numChildren<ChildTs>());
+				}
+
+			}, AllChildTypes_of<EntityT>());
+
+			m_numCreated		= 0;
+			m_numDestroyed		= 0;
+			m_numRelocations	= 0;
+		}
+
+		/*
+			Expects the next frame to create as many entities as the busiest of the recent frames.
+			Capacity grows at least twice when it is exceeded, so steady growth does not relocate entities every frame.
+			Slots freed by destroyed entities are reused, so destroys never lower the reservation.
+			Component rows, tags and sparse columns are reserved together with the entities.
+		*/
+		virtual void				reserve_for_next_frame() final override
+		{
+			m_createHistory[m_historyIndex]	= m_numCreatedInFrame;
+			m_historyIndex					= (m_historyIndex + 1) % CREATE_HISTORY;
+			m_numCreatedInFrame				= 0;
+
+			const uint32_t EXPECTED = *std::max_element(m_createHistory.begin(), m_createHistory.end());
+			const uint32_t REQUIRED	= size() + EXPECTED;
+			const uint32_t CAPACITY = (uint32_t)m_entities.capacity();
+			if(REQUIRED > CAPACITY) EntityPack_of::reserve_additional_space(std::max(REQUIRED, 2 * CAPACITY) - size());
+		}
 	};
 
 
@@ -3032,10 +4630,11 @@ namespace dpl
 	private:	// [SUBTYPES]
 		using	ComponentTypes	= AllComponentTypes_of<EntityT>;
 		using	ComponentArrays	= typename ComponentTypes::PtrPack;
+		using	SharedPages		= typename ComponentTypes::template encapsulate_in<CopyOnWritePages>::PtrPack;
 
 	public:		// [FRIENDS]
-		template<typename, bool>
-		friend class EntityStorageNode_t;
+		template<typename>
+		friend class EntityStorageNode;
 
 		template<typename>
 		friend class EntityPack_of;
@@ -3043,7 +4642,11 @@ namespace dpl
 	private:	// [DATA]
 		uint8_t*							rawEntityBuffer;
 		uint64_t							stride;
-		ComponentArrays						componentArrays;
+		ComponentArrays						componentArrays;	//<-- nullptr if the row shares its components with the fork.
+		SharedPages							sharedPages;		//<-- Pages of the shared components are copied when they are accessed for modification.
+#ifdef _DEBUG
+		const AccessTracker*				access; //<-- Tracker of the viewed pack.
+#endif // _DEBUG
 
 	public:		// [DATA]
 		ReadOnly<uint32_t, EntityPackView>	numEntities;
@@ -3053,13 +4656,18 @@ namespace dpl
 		CLASS_CTOR		EntityPackView(			EntityPack_of<DerivedEntityT>&	pack)
 			: rawEntityBuffer(reinterpret_cast<uint8_t*>(pack.find(0)) + dpl::base_offset<EntityT, DerivedEntityT>())
 			, stride(sizeof(DerivedEntityT))
-			, numEntities(pack.size())
+			, numEntities(pack.numActive())
 		{
+#ifdef _DEBUG
+			access = &pack.m_access;
+#endif // _DEBUG
 			if constexpr (ComponentTypes::SIZE > 0)
 			{
 				auto set_address = [&]<typename T>(T*& address)
 				{
-					address = pack.row<T>().modify();
+					auto& row = pack.template row<T>();
+					std::get<CopyOnWritePages<T>*>(sharedPages) = row.shared_pages();
+					address = std::get<CopyOnWritePages<T>*>(sharedPages)? nullptr : row.modify();
 				};
 
 				std::invoke([&]<typename... ComponentTs>(std::tuple<ComponentTs*...>& components)
@@ -3087,13 +4695,16 @@ namespace dpl
 		T&				component_at(			const uint32_t					INDEX)
 		{
 			throw_if_invalid_index(INDEX);
+			if(CopyOnWritePages<T>* pages = std::get<CopyOnWritePages<T>*>(sharedPages)) return *pages->at(INDEX);
 			return std::get<T*>(componentArrays)[INDEX];
 		}
 
+		// Shared component is read in place, see@ ComponentTable::Row::at.
 		template<dpl::is_one_of<ComponentTypes> T>
 		const T&		component_at(			const uint32_t					INDEX) const
 		{
 			throw_if_invalid_index(INDEX);
+			if(const CopyOnWritePages<T>* PAGES = std::get<CopyOnWritePages<T>*>(sharedPages)) return *PAGES->find(INDEX);
 			return std::get<T*>(componentArrays)[INDEX];
 		}
 
@@ -3660,15 +5271,14 @@ namespace dpl
 	class	EntityPack::CMD_DestroyHierarchy : public BinaryCommand
 	{
 	private:	// [DATA]
-		EntityManager::CMD_Destroy							m_root;
-		EntityManager::CommandGroupOf<CMD_DestroyHierarchy>	m_branches;
+		Reference				m_root;
+		std::vector<Reference>	m_hierarchy; // Root entity followed by all entities that strongly depend on it.
 
 	public:		// [LIFECYCLE]
 		CLASS_CTOR		CMD_DestroyHierarchy(	const Initializer&	INIT,
 												const Identity&		ROOT_ENTITY)
 			: BinaryCommand(INIT)
-			, m_root(INIT, ROOT_ENTITY)
-			, m_branches(INIT)
+			, m_root(ROOT_ENTITY)
 		{
 			
 		}
@@ -3676,23 +5286,44 @@ namespace dpl
 	private:	// [IMPLEMENTATION]
 		virtual void	on_first_execution(		BinaryState&		state) final override
 		{
-			EntityPack& pack = EntityManager::ref().get_base_variant(m_root.reference().storageID());
-			pack.for_each_dependent_child(m_root.reference().name(), STRONG_DEPENDENCY, [&](const Identity& CHILD_IDENTITY)
+			DestructionBatch batch;
+			batch.add_hierarchy(get_pack(m_root).get_identity(m_root.name()));
+			batch.for_each([&](const Identity& IDENTITY)
 			{
-				m_branches.add_command(BinaryCommand::Initializer(state), CHILD_IDENTITY);
+				m_hierarchy.emplace_back(IDENTITY);
 			});
 		}
 
 		virtual void	on_execute(				BinaryState&		state) final override
 		{
-			m_root.execute(state);
-			m_branches.execute(state);
+			DestructionBatch batch;
+			for(const Reference& REFERENCE : m_hierarchy)
+			{
+				EntityPack& pack = get_pack(REFERENCE);
+				pack.save_named_entity(REFERENCE.name(), state);
+				batch.add(pack.get_identity(REFERENCE.name()));
+			}
+			batch.destroy();
 		}
 
 		virtual void	on_unexecute(			BinaryState&		state) final override
 		{
-			m_branches.unexecute(state);
-			m_root.unexecute(state);
+			// All entities must exist before their relations are loaded.
+			for(const Reference& REFERENCE : m_hierarchy)
+			{
+				get_pack(REFERENCE).create_named_entity(REFERENCE.name());
+			}
+
+			for(const Reference& REFERENCE : m_hierarchy)
+			{
+				get_pack(REFERENCE).load_named_entity(REFERENCE.name(), state);
+			}
+		}
+
+	private:	// [INTERNAL FUNCTIONS]
+		static EntityPack&	get_pack(			const Reference&	REFERENCE)
+		{
+			return EntityManager::ref().get_base_variant(REFERENCE.storageID());
 		}
 	};
 
@@ -25,7 +25,7 @@ namespace dpl
 		friend Indexer<T>;
 
 	public: // constants
-		static const uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
 
 	private: // data
 		Indexer<T>* m_indexer;
@@ -0,0 +1,177 @@
+#pragma once
+
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "dpl_ClassInfo.h"
+
+
+namespace dpl
+{
+	/*
+		Move-only replacement of the std::function<void()>.
+		Callables that fit into INLINE_SIZE bytes and can be moved without throwing are stored in place,
+		larger ones are allocated on the heap. With the default size the whole task occupies one cache line.
+	*/
+	template<size_t INLINE_SIZE = 64 - sizeof(void*)>
+	class	InplaceTask
+	{
+	private: // subtypes
+		struct	VTable
+		{
+			void (*invoke)(void* storage);
+			void (*relocate)(void* destination, void* source) noexcept; //<-- Moves the callable and destroys the source.
+			void (*destroy)(void* storage) noexcept;
+		};
+
+		template<typename F>
+		struct	InlineModel
+		{
+			static F*			get(			void*			storage)
+			{
+				return std::launder(static_cast<F*>(storage));
+			}
+
+			static void			invoke(			void*			storage)
+			{
+				(*get(storage))();
+			}
+
+			static void			relocate(		void*			destination,
+												void*			source) noexcept
+			{
+				new(destination) F(std::move(*get(source)));
+				get(source)->~F();
+			}
+
+			static void			destroy(		void*			storage) noexcept
+			{
+				get(storage)->~F();
+			}
+
+			static constexpr VTable TABLE{&invoke, &relocate, &destroy};
+		};
+
+		template<typename F>
+		struct	HeapModel
+		{
+			static F*&			get(			void*			storage)
+			{
+				return *std::launder(static_cast<F**>(storage));
+			}
+
+			static void			invoke(			void*			storage)
+			{
+				(*get(storage))();
+			}
+
+			static void			relocate(		void*			destination,
+												void*			source) noexcept
+			{
+				new(destination) F*(get(source));
+			}
+
+			static void			destroy(		void*			storage) noexcept
+			{
+				delete get(storage);
+			}
+
+			static constexpr VTable TABLE{&invoke, &relocate, &destroy};
+		};
+
+	public: // constants
+		template<typename F>
+		static constexpr bool	IS_INLINE	=  sizeof(F) <= INLINE_SIZE
+											&& alignof(F) <= alignof(std::max_align_t)
+											&& std::is_nothrow_move_constructible_v<F>;
+
+	private: // data
+		alignas(std::max_align_t) mutable std::byte	m_storage[INLINE_SIZE];
+		const VTable*								m_vtable;
+
+	public: // lifecycle
+		CLASS_CTOR			InplaceTask() noexcept
+			: m_vtable(nullptr)
+		{
+
+		}
+
+		template<typename F> requires (!std::is_same_v<std::remove_cvref_t<F>, InplaceTask> && std::is_invocable_v<std::decay_t<F>&>)
+		CLASS_CTOR			InplaceTask(		F&&					function)
+		{
+			using Function = std::decay_t<F>;
+			if constexpr (IS_INLINE<Function>)
+			{
+				new(m_storage) Function(std::forward<F>(function));
+				m_vtable = &InlineModel<Function>::TABLE;
+			}
+			else
+			{
+				new(m_storage) Function*(new Function(std::forward<F>(function)));
+				m_vtable = &HeapModel<Function>::TABLE;
+			}
+		}
+
+		CLASS_CTOR			InplaceTask(		const InplaceTask&	OTHER) = delete;
+
+		CLASS_CTOR			InplaceTask(		InplaceTask&&		other) noexcept
+			: m_vtable(other.m_vtable)
+		{
+			if(m_vtable)
+			{
+				m_vtable->relocate(m_storage, other.m_storage);
+				other.m_vtable = nullptr;
+			}
+		}
+
+		CLASS_DTOR			~InplaceTask()
+		{
+			reset();
+		}
+
+		InplaceTask&		operator=(			const InplaceTask&	OTHER) = delete;
+
+		InplaceTask&		operator=(			InplaceTask&&		other) noexcept
+		{
+			if(this != &other)
+			{
+				reset();
+				if(other.m_vtable)
+				{
+					other.m_vtable->relocate(m_storage, other.m_storage);
+					m_vtable		= other.m_vtable;
+					other.m_vtable	= nullptr;
+				}
+			}
+			return *this;
+		}
+
+	public: // functions
+		explicit operator	bool() const noexcept
+		{
+			return m_vtable != nullptr;
+		}
+
+		/*
+			Task must not be empty.
+		*/
+		void				operator()() const
+		{
+			m_vtable->invoke(m_storage);
+		}
+
+		/*
+			Destroys stored callable(and releases its captures).
+		*/
+		void				reset() noexcept
+		{
+			if(m_vtable)
+			{
+				m_vtable->destroy(m_storage);
+				m_vtable = nullptr;
+			}
+		}
+	};
+}
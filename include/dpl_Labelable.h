@@ -68,6 +68,8 @@ namespace dpl
 		using Indexer		= std::function<uint32_t()>;
 		using MyBase::find_entry;
 		using MyBase::reserve;
+		using MyBase::get_loadFactor;
+		using MyBase::get_numBuckets;
 
 	public:		// [LIFECYCLE]
 		CLASS_CTOR				Labeler() = default;
@@ -12,8 +12,10 @@
 #include "dpl_Indexable.h"
 #include "dpl_Singleton.h"
 
+#ifdef _MSC_VER
 #pragma warning( disable : 26812 ) // Unscoped enum
 #pragma warning( disable : 26451 ) // Arithmetic overflow
+#endif
 
 namespace dpl
 {
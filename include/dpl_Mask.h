@@ -4,8 +4,10 @@
 #include <stdexcept>
 #include "dpl_ReadOnly.h"
 
+#ifdef _MSC_VER
 #pragma warning( disable : 26812 ) // Unscoped enum
 #pragma warning( disable : 4293 ) // shift count negative or too big
+#endif
 
 // set bit functions
 namespace dpl
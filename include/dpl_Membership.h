@@ -1,7 +1,11 @@
 #pragma once
 
 
+#include <vector>
+#include <span>
+#include <array>
 #include "dpl_Sequence.h"
+#include "dpl_std_addons.h"
 
 
 #pragma pack(push, 4)
@@ -14,6 +18,15 @@ namespace dpl
 
 	template<typename GroupT, typename MemberT, uint32_t ID = 0>
 	class Member;
+
+	template<typename T, uint32_t CAPACITY>
+	class InlineArray;
+
+	template<typename GroupT, typename MemberT, uint32_t ID = 0, uint32_t CAPACITY = 0>
+	class DenseGroup;
+
+	template<typename GroupT, typename MemberT, uint32_t ID = 0, uint32_t CAPACITY = 0>
+	class DenseMember;
 }
 
 // implemenations
@@ -367,6 +380,470 @@ namespace dpl
 		using MyBase::add_back;
 		using MyBase::remove_all;
 	};
+
+	/*
+		Vector-like array of trivial elements with fixed capacity, stored inline.
+	*/
+	template<typename T, uint32_t CAPACITY>
+	class InlineArray
+	{
+	private:	// [DATA]
+		std::array<T, CAPACITY>	m_elements;
+		uint32_t				m_size = 0;
+
+	public:		// [FUNCTIONS]
+		uint32_t				size() const
+		{
+			return m_size;
+		}
+
+		bool					empty() const
+		{
+			return m_size == 0;
+		}
+
+		T*						data()
+		{
+			return m_elements.data();
+		}
+
+		const T*				data() const
+		{
+			return m_elements.data();
+		}
+
+		T*						begin()
+		{
+			return data();
+		}
+
+		const T*				begin() const
+		{
+			return data();
+		}
+
+		T*						end()
+		{
+			return data() + m_size;
+		}
+
+		const T*				end() const
+		{
+			return data() + m_size;
+		}
+
+		T&						front()
+		{
+			return m_elements[0];
+		}
+
+		const T&				front() const
+		{
+			return m_elements[0];
+		}
+
+		T&						back()
+		{
+			return m_elements[m_size-1];
+		}
+
+		const T&				back() const
+		{
+			return m_elements[m_size-1];
+		}
+
+		T&						operator[](		const uint32_t		INDEX)
+		{
+			return m_elements[INDEX];
+		}
+
+		const T&				operator[](		const uint32_t		INDEX) const
+		{
+			return m_elements[INDEX];
+		}
+
+		void					push_back(		const T&			ELEMENT)
+		{
+			m_elements[m_size++] = ELEMENT;
+		}
+
+		void					pop_back()
+		{
+			--m_size;
+		}
+
+		void					clear()
+		{
+			m_size = 0;
+		}
+	};
+
+
+	/*
+		Can be attached to the dense group.
+		Knows its position in the group's array of members.
+	*/
+	template<typename GroupT, typename MemberT, uint32_t ID, uint32_t CAPACITY>
+	class DenseMember
+	{
+	public:		// [SUBTYPES]
+		using	MyGroup		= DenseGroup<GroupT, MemberT, ID, CAPACITY>;
+
+	public:		// [FRIENDS]
+		friend	MyGroup;
+
+	private:	// [DATA]
+		MyGroup*	m_group;
+		uint32_t	m_index;
+
+	protected:	// [LIFECYCLE]
+		CLASS_CTOR				DenseMember()
+			: m_group(nullptr)
+			, m_index(0)
+		{
+
+		}
+
+		CLASS_CTOR				DenseMember(	const DenseMember&	OTHER) = delete;
+
+		CLASS_CTOR				DenseMember(	DenseMember&&		other) noexcept
+			: m_group(other.m_group)
+			, m_index(other.m_index)
+		{
+			other.m_group = nullptr;
+			notify_moved();
+		}
+
+		CLASS_DTOR				~DenseMember()
+		{
+			dpl::no_except([&](){	detach();	});
+		}
+
+		DenseMember&			operator=(		const DenseMember&	OTHER) = delete;
+
+		DenseMember&			operator=(		DenseMember&&		other) noexcept
+		{
+			if(this != &other)
+			{
+				detach();
+				m_group			= other.m_group;
+				m_index			= other.m_index;
+				other.m_group	= nullptr;
+				notify_moved();
+			}
+
+			return *this;
+		}
+
+	public:		// [FUNCTIONS]
+		MemberT*				previous()
+		{
+			return (m_group && m_index > 0) ? m_group->m_members[m_index-1] : nullptr;
+		}
+
+		const MemberT*			previous() const
+		{
+			return (m_group && m_index > 0) ? m_group->m_members[m_index-1] : nullptr;
+		}
+
+		MemberT*				next()
+		{
+			return (m_group && m_index+1 < m_group->size()) ? m_group->m_members[m_index+1] : nullptr;
+		}
+
+		const MemberT*			next() const
+		{
+			return (m_group && m_index+1 < m_group->size()) ? m_group->m_members[m_index+1] : nullptr;
+		}
+
+		bool					is_member() const
+		{
+			return m_group != nullptr;
+		}
+
+		bool					is_member_of(	const MyGroup&		GROUP) const
+		{
+			return m_group == &GROUP;
+		}
+
+		const GroupT*			get_group() const
+		{
+			return m_group ? m_group->cast() : nullptr;
+		}
+
+	protected:	// [FUNCTIONS]
+		GroupT*					get_group()
+		{
+			return m_group ? m_group->cast() : nullptr;
+		}
+
+		/*
+			Remove this member from the group.
+			Last member of the group takes its place.
+		*/
+		void					detach()
+		{
+			if(m_group)
+			{
+				m_group->remove_at(m_index);
+			}
+		}
+
+	private:	// [FUNCTIONS]
+		MemberT*				cast()
+		{
+			return static_cast<MemberT*>(this);
+		}
+
+		void					notify_moved()
+		{
+			if(m_group) m_group->m_members[m_index] = cast();
+		}
+	};
+
+
+	/*
+		Stores (but not owns) contiguous array of members.
+		Unlike the Group, allows random access to members, but does not preserve their order on removal.
+		Non-zero CAPACITY limits the number of members and keeps the array inline (no heap allocations).
+		Moved member patches its own slot in O(1), moved group patches every member in O(N) (see@ update_members).
+	*/
+	template<typename GroupT, typename MemberT, uint32_t ID, uint32_t CAPACITY>
+	class DenseGroup
+	{
+	public:		// [SUBTYPES]
+		using	MyMember	= DenseMember<GroupT, MemberT, ID, CAPACITY>;
+		using	MyArray		= std::conditional_t<CAPACITY == 0, std::vector<MemberT*>, InlineArray<MemberT*, CAPACITY>>;
+
+	public:		// [FRIENDS]
+		friend	MyMember;
+
+	public:		// SUBTYPES
+		using	Invoke				= std::function<void(MemberT&)>;
+		using	InvokeConst			= std::function<void(const MemberT&)>;
+		using	InvokeUntil			= std::function<bool(MemberT&)>;
+		using	InvokeConstUntil	= std::function<bool(const MemberT&)>;
+
+	public:		// [CONSTANTS]
+		static constexpr uint32_t PREFETCH_DISTANCE = 4; //<-- Number of members fetched ahead during iteration.
+
+	private:	// [DATA]
+		MyArray m_members;
+
+	protected:	// [LIFECYCLE]
+		CLASS_CTOR				DenseGroup() = default;
+
+		CLASS_CTOR				DenseGroup(				const DenseGroup&			OTHER) = delete;
+
+		CLASS_CTOR				DenseGroup(				DenseGroup&&				other) noexcept
+			: m_members(std::move(other.m_members))
+		{
+			other.m_members.clear();
+			update_members();
+		}
+
+		CLASS_DTOR				~DenseGroup()
+		{
+			dpl::no_except([&](){	remove_all_members();	});
+		}
+
+		DenseGroup&				operator=(				const DenseGroup&			OTHER) = delete;
+
+		DenseGroup&				operator=(				DenseGroup&&				other) noexcept
+		{
+			if(this != &other)
+			{
+				remove_all_members();
+				m_members = std::move(other.m_members);
+				other.m_members.clear();
+				update_members();
+			}
+
+			return *this;
+		}
+
+	public:		// [FUNCTIONS]
+		uint32_t				size() const
+		{
+			return (uint32_t)m_members.size();
+		}
+
+		bool					empty() const
+		{
+			return m_members.empty();
+		}
+
+		bool					full() const
+		{
+			if constexpr(CAPACITY == 0)	return false;
+			else						return size() == CAPACITY;
+		}
+
+		const MemberT*			first() const
+		{
+			return empty()? nullptr : m_members.front();
+		}
+
+		const MemberT*			last() const
+		{
+			return empty()? nullptr : m_members.back();
+		}
+
+		const MemberT&			member_at(				const uint32_t				INDEX) const
+		{
+			return *m_members[INDEX];
+		}
+
+		std::span<const MemberT* const>	members() const
+		{
+			return std::span<const MemberT* const>(m_members.data(), m_members.size());
+		}
+
+		uint32_t				for_each_member(		const InvokeConst&			INVOKE) const
+		{
+			for(uint32_t index = 0; index < size(); ++index)
+			{
+				prefetch_ahead(index);
+				INVOKE(*m_members[index]);
+			}
+			return size();
+		}
+
+		/*
+			Invokes all members in a group until given function returns false.
+			Returns number of function calls.
+		*/
+		uint32_t				for_each_member_until(	const InvokeConstUntil&		INVOKE) const
+		{
+			uint32_t index = 0;
+			while(index < size())
+			{
+				prefetch_ahead(index);
+				if(!INVOKE(*m_members[index++])) break;
+			}
+			return index;
+		}
+
+	protected:	// [FUNCTIONS]
+		MemberT*				first()
+		{
+			return empty()? nullptr : m_members.front();
+		}
+
+		MemberT*				last()
+		{
+			return empty()? nullptr : m_members.back();
+		}
+
+		MemberT&				member_at(				const uint32_t				INDEX)
+		{
+			return *m_members[INDEX];
+		}
+
+		std::span<MemberT* const>	members()
+		{
+			return std::span<MemberT* const>(m_members.data(), m_members.size());
+		}
+
+		/*
+			Adds given member at the end of the group.
+			Returns false if member is already attached or the group is full.
+		*/
+		bool					add_end_member(			MyMember&					newMember)
+		{
+			if(newMember.m_group != this && !full())
+			{
+				newMember.detach();
+				newMember.m_group = this;
+				newMember.m_index = size();
+				m_members.push_back(newMember.cast());
+				return true;
+			}
+
+			return false;
+		}
+
+		uint32_t				for_each_member(		const Invoke&				INVOKE)
+		{
+			for(uint32_t index = 0; index < size(); ++index)
+			{
+				prefetch_ahead(index);
+				INVOKE(*m_members[index]);
+			}
+			return size();
+		}
+
+		/*
+			Invokes all members in a group until given function returns false.
+			Returns number of function calls.
+		*/
+		uint32_t				for_each_member_until(	const InvokeUntil&			INVOKE)
+		{
+			uint32_t index = 0;
+			while(index < size())
+			{
+				prefetch_ahead(index);
+				if(!INVOKE(*m_members[index++])) break;
+			}
+			return index;
+		}
+
+		bool					remove_member(			MyMember&					member)
+		{
+			if(!member.is_member_of(*this)) return false;
+			remove_at(member.m_index);
+			return true;
+		}
+
+		bool					remove_all_members()
+		{
+			if(empty()) return false;
+			for(MemberT* member : m_members)
+			{
+				static_cast<MyMember*>(member)->m_group = nullptr;
+			}
+			m_members.clear();
+			return true;
+		}
+
+	private:	// [FUNCTIONS]
+		GroupT*					cast()
+		{
+			return static_cast<GroupT*>(this);
+		}
+
+		const GroupT*			cast() const
+		{
+			return static_cast<const GroupT*>(this);
+		}
+
+		void					prefetch_ahead(			const uint32_t				INDEX) const
+		{
+			if(INDEX + PREFETCH_DISTANCE < size()) dpl::prefetch(m_members[INDEX + PREFETCH_DISTANCE]);
+		}
+
+		void					remove_at(				const uint32_t				INDEX)
+		{
+			static_cast<MyMember*>(m_members[INDEX])->m_group = nullptr;
+			if(INDEX+1 < size())
+			{
+				m_members[INDEX] = m_members.back();
+				static_cast<MyMember*>(m_members[INDEX])->m_index = INDEX;
+			}
+			m_members.pop_back();
+		}
+
+		/*
+			Updates pointer-to-group for each attached member.
+		*/
+		void					update_members()
+		{
+			for(MemberT* member : m_members)
+			{
+				static_cast<MyMember*>(member)->m_group = this;
+			}
+		}
+	};
 }
 
 #pragma pack(pop)
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "dpl_ReadOnly.h"
 #include <string>
+#include <typeinfo>
 
 
 namespace dpl
@@ -0,0 +1,361 @@
+#pragma once
+
+
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <type_traits>
+#include "dpl_ThreadPool.h"
+#include "dpl_Range.h"
+
+
+namespace dpl
+{
+	/*
+		Range of indices consumed from the front by its owner and split in half from the back by thieves.
+		Both ends are packed into one atomic word, so that claiming and stealing are single CAS operations.
+	*/
+	template<std::unsigned_integral IndexT = uint32_t>
+	class alignas(64) StealableRange
+	{
+	private: // subtypes
+		static_assert(sizeof(IndexT) <= sizeof(uint32_t), "Both ends of the StealableRange must fit into 64 bits.");
+
+	private: // data
+		std::atomic<uint64_t> m_packed;
+
+	public: // lifecycle
+		CLASS_CTOR					StealableRange()
+			: m_packed(0)
+		{
+
+		}
+
+	public: // functions
+		IndexT						remaining() const
+		{
+			const uint64_t PACKED = m_packed.load(std::memory_order_relaxed);
+			return get_end(PACKED) - get_begin(PACKED);
+		}
+
+		void						reset(			const IndexRange<IndexT>&	RANGE)
+		{
+			m_packed.store(pack(RANGE.begin(), RANGE.end()), std::memory_order_release);
+		}
+
+		/*
+			Owner only. Claims up to GRAIN indices from the front.
+		*/
+		bool						claim_front(	const IndexT				GRAIN,
+													IndexRange<IndexT>&			claimed)
+		{
+			uint64_t packed = m_packed.load(std::memory_order_acquire);
+			while(true)
+			{
+				const IndexT BEGIN	= get_begin(packed);
+				const IndexT END	= get_end(packed);
+				if(BEGIN >= END)
+					return false;
+
+				const IndexT NEW_BEGIN = (END - BEGIN > GRAIN) ? BEGIN + GRAIN : END;
+				if(m_packed.compare_exchange_weak(packed, pack(NEW_BEGIN, END), std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					claimed.reset(BEGIN, NEW_BEGIN);
+					return true;
+				}
+			}
+		}
+
+		/*
+			Any thread. Takes the back half if at least MIN_SIZE indices remain(owner keeps the front half).
+			Returns false if there is not enough to steal or another thread modified the range in the meantime.
+		*/
+		bool						steal_back(		const IndexT				MIN_SIZE,
+													IndexRange<IndexT>&			stolen)
+		{
+			uint64_t		packed	= m_packed.load(std::memory_order_acquire);
+			const IndexT	BEGIN	= get_begin(packed);
+			const IndexT	END		= get_end(packed);
+			if(BEGIN >= END || END - BEGIN < MIN_SIZE)
+				return false;
+
+			const IndexT MIDDLE = BEGIN + (END - BEGIN + 1) / 2;
+			if(!m_packed.compare_exchange_strong(packed, pack(BEGIN, MIDDLE), std::memory_order_acq_rel, std::memory_order_relaxed))
+				return false;
+
+			stolen.reset(MIDDLE, END);
+			return true;
+		}
+
+	private: // functions
+		static uint64_t				pack(			const IndexT				BEGIN,
+													const IndexT				END)
+		{
+			return (static_cast<uint64_t>(BEGIN) << 32) | static_cast<uint64_t>(END);
+		}
+
+		static IndexT				get_begin(		const uint64_t				PACKED)
+		{
+			return static_cast<IndexT>(PACKED >> 32);
+		}
+
+		static IndexT				get_end(		const uint64_t				PACKED)
+		{
+			return static_cast<IndexT>(PACKED & 0xFFFFFFFFull);
+		}
+	};
+
+
+	namespace Parallel
+	{
+		inline constexpr uint32_t	CHUNKS_PER_CLAIMER	= 8;	//<-- Automatic grain gives each claimer about that many chunks of its initial share.
+		inline constexpr uint32_t	MIN_AUTO_GRAIN		= 64;	//<-- Lower bound of the automatic grain(pass explicit grain for expensive bodies).
+		inline constexpr uint32_t	MIN_SCAN_BLOCK_SIZE	= 4096;	//<-- Smaller scans are done serially.
+
+		/*
+			Wraps the value so that values of neighbouring workers never share a cache line.
+		*/
+		template<typename T>
+		struct alignas(64) CacheLinePadded
+		{
+			T value;
+		};
+
+		template<std::unsigned_integral IndexT>
+		inline IndexT				get_grain(		const ParallelPhase&		PHASE,
+													const IndexRange<IndexT>&	RANGE,
+													const IndexT				GRAIN)
+		{
+			if(GRAIN > 0)
+				return GRAIN;
+
+			const IndexT NUM_CLAIMERS = static_cast<IndexT>(PHASE.numJobs() + 1);
+			return std::max<IndexT>(MIN_AUTO_GRAIN, RANGE.size() / (NUM_CLAIMERS * CHUNKS_PER_CLAIMER));
+		}
+
+		/*
+			Returns 1 if the RANGE should be processed serially.
+		*/
+		template<std::unsigned_integral IndexT>
+		inline uint32_t				get_numClaimers(const ParallelPhase&		PHASE,
+													const IndexRange<IndexT>&	RANGE,
+													const IndexT				GRAIN_SIZE)
+		{
+			if(PHASE.numJobs() == 0 || RANGE.size() < 2 * GRAIN_SIZE)
+				return 1;
+
+			return std::min<uint32_t>(PHASE.numJobs() + 1, RANGE.size() / GRAIN_SIZE);
+		}
+
+		/*
+			Steals the back half of the largest range(of at least 2 grains) and makes it the range of the THIEF.
+		*/
+		template<std::unsigned_integral IndexT>
+		inline bool					steal_largest(	StealableRange<IndexT>*		ranges,
+													const uint32_t				NUM_RANGES,
+													const uint32_t				THIEF,
+													const IndexT				GRAIN)
+		{
+			IndexRange<IndexT> stolen;
+			while(true)
+			{
+				uint32_t	victim		= NUM_RANGES;
+				IndexT		largest		= 0;
+				for(uint32_t index = 0; index < NUM_RANGES; ++index)
+				{
+					const IndexT REMAINING = ranges[index].remaining();
+					if(index != THIEF && REMAINING > largest)
+					{
+						victim	= index;
+						largest	= REMAINING;
+					}
+				}
+
+				if(victim == NUM_RANGES || largest < 2 * GRAIN)
+					return false; //<-- Owners finish the rest faster than thieves could split it.
+
+				if(ranges[victim].steal_back(2 * GRAIN, stolen))
+				{
+					ranges[THIEF].reset(stolen);
+					return true;
+				}
+			}
+		}
+
+		/*
+			Each claimer(phase jobs + calling thread) starts with an equal share and consumes it chunk by chunk.
+			Claimers that run out of work steal the back half of the largest remaining share,
+			so shares are split only when a thief appears.
+			INVOKE receives the ID of the claimer(less than NUM_CLAIMERS) and the chunk.
+		*/
+		template<std::unsigned_integral IndexT, typename InvokeClaimedT>
+		inline void					for_each_chunk(	ParallelPhase&				phase,
+													const IndexRange<IndexT>&	RANGE,
+													const IndexT				GRAIN_SIZE,
+													const uint32_t				NUM_CLAIMERS,
+													const InvokeClaimedT&		INVOKE)
+		{
+			if(NUM_CLAIMERS <= 1)
+			{
+				if(!RANGE.empty()) INVOKE(0u, RANGE);
+				return;
+			}
+
+			std::unique_ptr<StealableRange<IndexT>[]> ranges(new StealableRange<IndexT>[NUM_CLAIMERS]);
+
+			uint32_t claimerID = 0;
+			RANGE.for_each_split(NUM_CLAIMERS, [&](const IndexRange<IndexT>& SHARE)
+			{
+				ranges[claimerID++].reset(SHARE);
+			});
+
+			for(claimerID = 0; claimerID < NUM_CLAIMERS; ++claimerID)
+			{
+				phase.add_task(ranges[claimerID].remaining(), [&, claimerID]()
+				{
+					IndexRange<IndexT> chunk;
+					do
+					{
+						while(ranges[claimerID].claim_front(GRAIN_SIZE, chunk))
+						{
+							INVOKE(claimerID, chunk);
+						}
+					}
+					while(steal_largest(ranges.get(), NUM_CLAIMERS, claimerID, GRAIN_SIZE));
+				});
+			}
+
+			phase.start();
+		}
+	}
+
+
+	/*
+		Invokes subranges(chunks of at most GRAIN indices) of the RANGE in parallel and waits until all are done.
+		Shares of the range are split on demand(see Parallel::for_each_chunk).
+		GRAIN == 0 selects the grain automatically. Ranges smaller than 2 grains are invoked serially.
+	*/
+	template<std::unsigned_integral IndexT, typename InvokeSubrangeT>
+	inline void						parallel_for(	ParallelPhase&						phase,
+													const IndexRange<IndexT>&			RANGE,
+													const InvokeSubrangeT&				INVOKE,
+													const std::type_identity_t<IndexT>	GRAIN = 0)
+	{
+		const IndexT	GRAIN_SIZE		= Parallel::get_grain(phase, RANGE, GRAIN);
+		const uint32_t	NUM_CLAIMERS	= Parallel::get_numClaimers(phase, RANGE, GRAIN_SIZE);
+
+		Parallel::for_each_chunk(phase, RANGE, GRAIN_SIZE, NUM_CLAIMERS, [&](const uint32_t, const IndexRange<IndexT>& CHUNK)
+		{
+			INVOKE(CHUNK);
+		});
+	}
+
+	/*
+		Returns COMBINE of IDENTITY and MAP(index) of all indices in the RANGE.
+		Each claimer accumulates into its own cache line padded partial, partials are combined in the calling thread.
+		COMBINE must be associative and commutative(stolen chunks change the order of accumulation).
+	*/
+	template<std::unsigned_integral IndexT, typename T, typename MapT, typename CombineT>
+	inline T						parallel_reduce(ParallelPhase&						phase,
+													const IndexRange<IndexT>&			RANGE,
+													const T&							IDENTITY,
+													const MapT&							MAP,
+													const CombineT&						COMBINE,
+													const std::type_identity_t<IndexT>	GRAIN = 0)
+	{
+		const IndexT	GRAIN_SIZE		= Parallel::get_grain(phase, RANGE, GRAIN);
+		const uint32_t	NUM_CLAIMERS	= Parallel::get_numClaimers(phase, RANGE, GRAIN_SIZE);
+
+		std::vector<Parallel::CacheLinePadded<T>> partials(NUM_CLAIMERS, Parallel::CacheLinePadded<T>{IDENTITY});
+
+		Parallel::for_each_chunk(phase, RANGE, GRAIN_SIZE, NUM_CLAIMERS, [&](const uint32_t CLAIMER_ID, const IndexRange<IndexT>& CHUNK)
+		{
+			T& partial = partials[CLAIMER_ID].value;
+			for(IndexT index = CHUNK.begin(); index < CHUNK.end(); ++index)
+			{
+				partial = COMBINE(std::move(partial), MAP(index));
+			}
+		});
+
+		T result = IDENTITY;
+		for(auto& partial : partials)
+		{
+			result = COMBINE(std::move(result), std::move(partial.value));
+		}
+		return result;
+	}
+
+	/*
+		Replaces each value with OP of INIT and all values before it, returns OP of INIT and all values.
+		Values are split into one block per claimer: block totals are computed in parallel,
+		scanned serially into block offsets and then each block is scanned in parallel from its offset.
+		OP must be associative.
+	*/
+	template<typename T, typename OpT>
+	inline T						parallel_exclusive_scan(ParallelPhase&				phase,
+															std::span<T>				values,
+															const OpT&					OP,
+															const T&					INIT = T())
+	{
+		const uint32_t NUM_VALUES = static_cast<uint32_t>(values.size());
+		const uint32_t NUM_BLOCKS = std::min<uint32_t>(phase.numJobs() + 1, NUM_VALUES / Parallel::MIN_SCAN_BLOCK_SIZE);
+
+		auto scan_block = [&](const IndexRange<>& BLOCK, T running)
+		{
+			for(uint32_t index = BLOCK.begin(); index < BLOCK.end(); ++index)
+			{
+				T value = std::move(values[index]);
+				values[index] = running;
+				running = OP(std::move(running), std::move(value));
+			}
+			return running;
+		};
+
+		if(NUM_BLOCKS <= 1)
+			return scan_block(IndexRange<>(0, NUM_VALUES), INIT);
+
+		std::vector<IndexRange<>>					blocks;
+		std::vector<Parallel::CacheLinePadded<T>>	partials(NUM_BLOCKS, Parallel::CacheLinePadded<T>{INIT});
+		blocks.reserve(NUM_BLOCKS);
+		IndexRange<>(0, NUM_VALUES).for_each_split(NUM_BLOCKS, [&](const IndexRange<>& BLOCK)
+		{
+			blocks.push_back(BLOCK);
+		});
+
+		for(uint32_t blockID = 0; blockID < NUM_BLOCKS; ++blockID)
+		{
+			phase.add_task(blocks[blockID].size(), [&, blockID]()
+			{
+				const IndexRange<>& BLOCK = blocks[blockID];
+				T total = values[BLOCK.begin()];
+				for(uint32_t index = BLOCK.begin() + 1; index < BLOCK.end(); ++index)
+				{
+					total = OP(std::move(total), values[index]);
+				}
+				partials[blockID].value = std::move(total);
+			});
+		}
+		phase.start();
+
+		T offset = INIT; //<-- Block totals become block offsets.
+		for(auto& partial : partials)
+		{
+			T total = std::move(partial.value);
+			partial.value = offset;
+			offset = OP(std::move(offset), std::move(total));
+		}
+
+		for(uint32_t blockID = 0; blockID < NUM_BLOCKS; ++blockID)
+		{
+			phase.add_task(blocks[blockID].size(), [&, blockID]()
+			{
+				scan_block(blocks[blockID], partials[blockID].value);
+			});
+		}
+		phase.start();
+
+		return offset;
+	}
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <mutex>
+#include "dpl_ClassInfo.h"
+
+
+namespace dpl
+{
+	/*
+		Process-wide pool of memory blocks of the BLOCK_SIZE with a small cache per thread.
+		Blocks are never returned to the system, so the pool is meant for short-lived objects
+		that are created and destroyed at a high rate(e.g. shared states of the futures).
+	*/
+	template<size_t BLOCK_SIZE>
+	class	BlockPool
+	{
+	private: // subtypes
+		struct	FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct	Shared
+		{
+			std::mutex	mtx;
+			FreeBlock*	head = nullptr;
+		};
+
+		struct	Cache
+		{
+			FreeBlock*	head = nullptr;
+			uint32_t	size = 0;
+
+			CLASS_DTOR ~Cache()
+			{
+				sm_bClosed = true; //<-- Blocks released later by this thread go straight to the shared list.
+				while(head)
+				{
+					FreeBlock* block = head;
+					head = head->next;
+					push_shared(block);
+				}
+			}
+		};
+
+		static_assert(BLOCK_SIZE >= sizeof(FreeBlock), "Block is too small.");
+
+	private: // constants
+		static constexpr uint32_t			MAX_CACHED	= 64; //<-- Blocks over this limit go to the shared list.
+
+	private: // data
+		static inline thread_local Cache	sm_cache;
+		static inline thread_local bool		sm_bClosed	= false;
+
+	public: // functions
+		static void*		allocate()
+		{
+			if(!sm_bClosed && sm_cache.head)
+			{
+				FreeBlock* block = sm_cache.head;
+				sm_cache.head = block->next;
+				--sm_cache.size;
+				return block;
+			}
+
+			Shared& shared = get_shared();
+			{std::lock_guard lk(shared.mtx);
+				if(FreeBlock* block = shared.head)
+				{
+					shared.head = block->next;
+					return block;
+				}
+			}
+
+			return ::operator new(BLOCK_SIZE);
+		}
+
+		static void			deallocate(	void*		memory)
+		{
+			FreeBlock* block = static_cast<FreeBlock*>(memory);
+			if(!sm_bClosed && sm_cache.size < MAX_CACHED)
+			{
+				block->next = sm_cache.head;
+				sm_cache.head = block;
+				++sm_cache.size;
+				return;
+			}
+
+			push_shared(block);
+		}
+
+	private: // functions
+		// Never destroyed, blocks may be released during the static destruction.
+		static Shared&		get_shared()
+		{
+			static Shared* instance = new Shared();
+			return *instance;
+		}
+
+		static void			push_shared(FreeBlock*	block)
+		{
+			Shared& shared = get_shared();
+			std::lock_guard lk(shared.mtx);
+			block->next = shared.head;
+			shared.head = block;
+		}
+	};
+
+
+	/*
+		Standard allocator that takes memory from the BlockPool of the size rounded up to the cache line.
+		Allocations larger than MAX_POOLED_SIZE or over-aligned ones fall back to the operator new.
+	*/
+	template<typename T>
+	class	PoolAllocator
+	{
+	public: // subtypes
+		using	value_type = T;
+
+	public: // constants
+		static constexpr size_t	GRANULARITY		= 64;
+		static constexpr size_t	MAX_POOLED_SIZE	= 4 * GRANULARITY;
+
+	public: // lifecycle
+		CLASS_CTOR			PoolAllocator() noexcept = default;
+
+		template<typename U>
+		CLASS_CTOR			PoolAllocator(	const PoolAllocator<U>&	OTHER) noexcept
+		{
+
+		}
+
+	public: // functions
+		T*					allocate(		const size_t			COUNT)
+		{
+			if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				return static_cast<T*>(::operator new(COUNT * sizeof(T), std::align_val_t(alignof(T))));
+			}
+			else
+			{
+				switch(get_sizeClass(COUNT))
+				{
+				case 1:		return static_cast<T*>(BlockPool<1 * GRANULARITY>::allocate());
+				case 2:		return static_cast<T*>(BlockPool<2 * GRANULARITY>::allocate());
+				case 3:		return static_cast<T*>(BlockPool<3 * GRANULARITY>::allocate());
+				case 4:		return static_cast<T*>(BlockPool<4 * GRANULARITY>::allocate());
+				default:	return static_cast<T*>(::operator new(COUNT * sizeof(T)));
+				}
+			}
+		}
+
+		void				deallocate(		T*						memory,
+											const size_t			COUNT) noexcept
+		{
+			if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				::operator delete(memory, std::align_val_t(alignof(T)));
+			}
+			else
+			{
+				switch(get_sizeClass(COUNT))
+				{
+				case 1:		BlockPool<1 * GRANULARITY>::deallocate(memory); break;
+				case 2:		BlockPool<2 * GRANULARITY>::deallocate(memory); break;
+				case 3:		BlockPool<3 * GRANULARITY>::deallocate(memory); break;
+				case 4:		BlockPool<4 * GRANULARITY>::deallocate(memory); break;
+				default:	::operator delete(memory); break;
+				}
+			}
+		}
+
+		template<typename U>
+		bool				operator==(		const PoolAllocator<U>&	OTHER) const noexcept
+		{
+			return true;
+		}
+
+	private: // functions
+		static size_t		get_sizeClass(	const size_t			COUNT)
+		{
+			const size_t SIZE = COUNT * sizeof(T);
+			return (SIZE <= MAX_POOLED_SIZE)? (SIZE + GRANULARITY - 1) / GRANULARITY : 0;
+		}
+	};
+}
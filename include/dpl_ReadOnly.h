@@ -2,6 +2,7 @@
 
 
 #include <utility>
+#include <cstdint>
 #include "dpl_ClassInfo.h"
 
 
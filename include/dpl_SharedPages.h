@@ -0,0 +1,391 @@
+#pragma once
+
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include "dpl_Buffer.h"
+
+
+namespace dpl
+{
+	/*
+		Elements shared by the copy-on-write arrays(see@ CopyOnWritePages), divided into pages with separate reference counts.
+		Elements of the page are destroyed when the last array that refers to it releases it (detach or destruction of the array).
+	*/
+	template<typename T>
+	class	SharedPages
+	{
+	public: // constants
+		static constexpr uint32_t PAGE_SIZE = (sizeof(T) < 4096)? static_cast<uint32_t>(4096 / sizeof(T)) : 1; //<-- Number of elements.
+
+	private: // data
+		Buffer<T>									m_buffer;
+		uint32_t									m_size;
+		std::unique_ptr<std::atomic<uint32_t>[]>	m_pageRefs;
+		std::atomic<uint32_t>						m_numSharers;
+
+	public: // lifecycle
+		CLASS_CTOR					SharedPages(	Buffer<T>&&		buffer,
+													const uint32_t	SIZE)
+			: m_buffer(std::move(buffer))
+			, m_size(SIZE)
+			, m_pageRefs(std::make_unique<std::atomic<uint32_t>[]>(count_pages(SIZE)))
+			, m_numSharers(1)
+		{
+			for(uint32_t page = 0; page < numPages(); ++page)
+			{
+				m_pageRefs[page].store(1, std::memory_order_relaxed);
+			}
+		}
+
+		CLASS_CTOR					SharedPages(	const SharedPages&	OTHER) = delete;
+		SharedPages&				operator=(		const SharedPages&	OTHER) = delete;
+
+	public: // functions
+		static uint32_t				count_pages(	const uint32_t	SIZE)
+		{
+			return (SIZE + PAGE_SIZE - 1) / PAGE_SIZE;
+		}
+
+		uint32_t					numPages() const
+		{
+			return count_pages(m_size);
+		}
+
+		uint32_t					size() const
+		{
+			return m_size;
+		}
+
+		uint32_t					capacity() const
+		{
+			return m_buffer.capacity();
+		}
+
+		const T*					data() const
+		{
+			return m_buffer.data();
+		}
+
+		// Returns index of the element at the given ADDRESS (or INVALID_INDEX if out of range).
+		uint32_t					index_of(		const T*		ADDRESS) const
+		{
+			return m_buffer.index_of(ADDRESS);
+		}
+
+		bool						is_sole_sharer() const
+		{
+			return m_numSharers.load(std::memory_order_acquire) == 1;
+		}
+
+		/*
+			Adds a reference to every page, caller must still refer to all of them.
+		*/
+		void						add_sharer()
+		{
+			m_numSharers.fetch_add(1, std::memory_order_relaxed);
+			for(uint32_t page = 0; page < numPages(); ++page)
+			{
+				m_pageRefs[page].fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		// Constructs copies of the elements of the PAGE at the same indices of the TARGET, the caller keeps its reference to the PAGE.
+		void						copy_page(		const uint32_t	PAGE,
+													Buffer<T>&		target) const
+		{
+			const uint32_t BEGIN = PAGE * PAGE_SIZE;
+			target.copy_from(m_buffer.data(), std::min(m_size - BEGIN, PAGE_SIZE), BEGIN, BEGIN);
+		}
+
+		/*
+			Constructs elements of the PAGE at the same indices of the TARGET and drops the caller's reference to the PAGE.
+			Elements are moved instead of copied if the caller is the last one that refers to the PAGE.
+		*/
+		void						take_page(		const uint32_t	PAGE,
+													Buffer<T>&		target)
+		{
+			const uint32_t BEGIN = PAGE * PAGE_SIZE;
+			const uint32_t COUNT = std::min(m_size - BEGIN, PAGE_SIZE);
+			if(m_pageRefs[PAGE].load(std::memory_order_acquire) == 1)
+			{
+				target.move_from(m_buffer, COUNT, BEGIN, BEGIN);
+				m_pageRefs[PAGE].store(0, std::memory_order_relaxed);
+			}
+			else
+			{
+				copy_page(PAGE, target);
+				release_page(PAGE);
+			}
+		}
+
+		void						release_page(	const uint32_t	PAGE)
+		{
+			if(m_pageRefs[PAGE].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				const uint32_t BEGIN = PAGE * PAGE_SIZE;
+				m_buffer.destroy_range(BEGIN, std::min(m_size - BEGIN, PAGE_SIZE));
+			}
+		}
+
+		/*
+			Moves out the whole buffer, caller must be the only sharer that still refers to all pages.
+		*/
+		Buffer<T>					take_buffer()
+		{
+			for(uint32_t page = 0; page < numPages(); ++page)
+			{
+				m_pageRefs[page].store(0, std::memory_order_relaxed);
+			}
+			return std::move(m_buffer);
+		}
+
+		/*
+			Drops the caller's share(pages must be released first), the last one deletes the pages.
+		*/
+		static void					release(		SharedPages*	pages)
+		{
+			if(pages->m_numSharers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				delete pages;
+			}
+		}
+	};
+
+
+	/*
+		Array of the fixed size that shares elements with other arrays until they are modified.
+		Modified page is copied to the local buffer at the same indices, so the addresses of the elements
+		stay valid when the local buffer is detached(e.g. to be adopted by the DynamicArray).
+		Const access reads the shared page in place until the page is copied, the array keeps its reference
+		to every page until it is detached or destroyed, so the shared elements stay valid for concurrent readers.
+		Access to the elements is thread-safe, detach and destruction require exclusive access.
+	*/
+	template<typename T>
+	class	CopyOnWritePages
+	{
+	private: // subtypes
+		using	MyShared	= SharedPages<T>;
+
+	private: // data
+		MyShared*							m_shared;
+		Buffer<T>							m_local;
+		T* const							m_elements;	//<-- Local buffer, still valid after it was detached.
+		uint32_t							m_size;
+		std::unique_ptr<std::atomic<bool>[]>m_bCopied;
+		std::atomic<uint32_t>				m_numCopied;
+		std::atomic<bool>					m_bDetached;
+		mutable std::mutex					m_mtx;
+
+	public: // lifecycle
+		/*
+			Shares the BUFFER with SIZE constructed elements, see@ share.
+		*/
+		CLASS_CTOR					CopyOnWritePages(	Buffer<T>&&			buffer,
+														const uint32_t		SIZE)
+			: CopyOnWritePages(new MyShared(std::move(buffer), SIZE))
+		{
+
+		}
+
+		CLASS_CTOR					CopyOnWritePages(	const CopyOnWritePages&	OTHER) = delete;
+		CopyOnWritePages&			operator=(			const CopyOnWritePages&	OTHER) = delete;
+
+		CLASS_DTOR					~CopyOnWritePages()
+		{
+			if(is_detached()) return;
+
+			for(uint32_t page = 0; page < m_shared->numPages(); ++page)
+			{
+				if(m_bCopied[page].load(std::memory_order_relaxed))
+				{
+					const uint32_t BEGIN = page * MyShared::PAGE_SIZE;
+					m_local.destroy_range(BEGIN, std::min(m_size - BEGIN, MyShared::PAGE_SIZE));
+				}
+				m_shared->release_page(page);
+			}
+			MyShared::release(m_shared);
+		}
+
+	private: // lifecycle
+		CLASS_CTOR					CopyOnWritePages(	MyShared*			shared)
+			: m_shared(shared)
+			, m_local(shared->capacity()) //<-- Memory is not touched until the pages are copied.
+			, m_elements(m_local.data())
+			, m_size(shared->size())
+			, m_bCopied(std::make_unique<std::atomic<bool>[]>(shared->numPages()))
+			, m_numCopied(0)
+			, m_bDetached(false)
+		{
+
+		}
+
+	public: // functions
+		uint32_t					size() const
+		{
+			return m_size;
+		}
+
+		// Capacity of the local buffer (array must not be detached).
+		uint32_t					capacity() const
+		{
+			return m_local.capacity();
+		}
+
+		bool						is_detached() const
+		{
+			return m_bDetached.load(std::memory_order_acquire);
+		}
+
+		/*
+			Returns true if another array can share the same pages (nothing was copied yet).
+		*/
+		bool						can_share() const
+		{
+			return !is_detached() && m_numCopied.load(std::memory_order_acquire) == 0;
+		}
+
+		/*
+			Returns new array that refers to the same pages, see@ can_share.
+		*/
+		std::unique_ptr<CopyOnWritePages>	share()
+		{
+			std::lock_guard lk(m_mtx);
+			m_shared->add_sharer();
+			return std::unique_ptr<CopyOnWritePages>(new CopyOnWritePages(m_shared));
+		}
+
+		/*
+			Returns address of the element in the local buffer, its page is copied on the first call (modification is expected).
+			Returns nullptr if the array was detached.
+		*/
+		T*							at(					const uint32_t		INDEX)
+		{
+			const uint32_t PAGE = INDEX / MyShared::PAGE_SIZE;
+			if(!m_bCopied[PAGE].load(std::memory_order_acquire))
+			{
+				std::lock_guard lk(m_mtx);
+				if(m_bDetached.load(std::memory_order_relaxed)) return nullptr;
+				copy_page(PAGE);
+			}
+			return m_elements + INDEX;
+		}
+
+		/*
+			Returns address of the element without copying its page (shared element if the page was not modified yet).
+			Returns nullptr if the array was detached.
+		*/
+		const T*					find(				const uint32_t		INDEX) const
+		{
+			if(m_bCopied[INDEX / MyShared::PAGE_SIZE].load(std::memory_order_acquire)) return m_elements + INDEX;
+			if(is_detached()) return nullptr;
+			return m_shared->data() + INDEX;
+		}
+
+		/*
+			Invokes READ_PAGE(const T* FIRST, uint32_t NUM_ELEMENTS) for each page in order, without copying any of them.
+			Array must not be detached.
+		*/
+		template<typename ReadPageT>
+		void						for_each_page(		ReadPageT&&			READ_PAGE) const
+		{
+			for(uint32_t page = 0; page < m_shared->numPages(); ++page)
+			{
+				const uint32_t BEGIN = page * MyShared::PAGE_SIZE;
+				READ_PAGE(find(BEGIN), std::min(m_size - BEGIN, MyShared::PAGE_SIZE));
+			}
+		}
+
+		/*
+			Returns address of the first element of the local buffer with all pages copied (whole array is expected to be modified).
+			Returns nullptr if the array was detached.
+		*/
+		T*							copy_all()
+		{
+			if(m_numCopied.load(std::memory_order_acquire) < m_shared->numPages())
+			{
+				std::lock_guard lk(m_mtx);
+				if(m_bDetached.load(std::memory_order_relaxed)) return nullptr;
+				for(uint32_t page = 0; page < m_shared->numPages(); ++page)
+				{
+					copy_page(page);
+				}
+			}
+			return m_elements;
+		}
+
+		/*
+			Returns address of the first element of the contiguous array of all elements: shared buffer if no page was copied yet,
+			otherwise the local buffer with the remaining pages copied. Returns nullptr if the array was detached.
+		*/
+		const T*					read_all() const
+		{
+			if(m_numCopied.load(std::memory_order_acquire) == 0)
+			{
+				std::lock_guard lk(m_mtx);
+				if(m_bDetached.load(std::memory_order_relaxed)) return nullptr;
+				if(m_numCopied.load(std::memory_order_relaxed) == 0) return m_shared->data();
+			}
+			return const_cast<CopyOnWritePages*>(this)->copy_all(); //<-- Pages must be merged into one buffer.
+		}
+
+		/*
+			Returns index of the element at the given ADDRESS in the local or in the shared buffer (or INVALID_INDEX if out of range).
+			ON_DETACHED() is returned instead if the array was detached (it is called after the adopting array took the elements).
+		*/
+		template<typename OnDetachedT>
+		uint32_t					index_of(			const T*			ADDRESS,
+														OnDetachedT&&		ON_DETACHED) const
+		{
+			std::lock_guard lk(m_mtx);
+			if(m_bDetached.load(std::memory_order_relaxed)) return ON_DETACHED();
+			const uint32_t LOCAL_INDEX = m_local.index_of(ADDRESS);
+			if(LOCAL_INDEX < m_size) return LOCAL_INDEX;
+			const uint32_t SHARED_INDEX = m_shared->index_of(ADDRESS);
+			return (SHARED_INDEX < m_size)? SHARED_INDEX : Buffer<T>::INVALID_INDEX;
+		}
+
+		/*
+			Copies remaining pages, releases all shared pages and passes the local buffer with all elements to the ADOPT(Buffer<T>&&, uint32_t SIZE) once.
+			Buffer of the shared pages is passed instead if nobody else refers to them and nothing was copied.
+		*/
+		template<typename AdoptT>
+		void						detach(				AdoptT&&			ADOPT)
+		{
+			std::lock_guard lk(m_mtx);
+			if(m_bDetached.load(std::memory_order_relaxed)) return;
+
+			Buffer<T> detached;
+			if(m_numCopied.load(std::memory_order_relaxed) == 0 && m_shared->is_sole_sharer())
+			{
+				detached = m_shared->take_buffer();
+			}
+			else
+			{
+				for(uint32_t page = 0; page < m_shared->numPages(); ++page)
+				{
+					if(m_bCopied[page].load(std::memory_order_relaxed))	m_shared->release_page(page);
+					else												m_shared->take_page(page, m_local);
+				}
+				detached = std::move(m_local);
+			}
+
+			MyShared::release(m_shared);
+			m_shared = nullptr;
+			ADOPT(std::move(detached), m_size);
+			m_bDetached.store(true, std::memory_order_release);
+		}
+
+	private: // functions
+		// Copy keeps the reference to the shared page, so that concurrent readers of the shared elements are not affected.
+		void						copy_page(			const uint32_t		PAGE)
+		{
+			if(m_bCopied[PAGE].load(std::memory_order_relaxed)) return;
+			m_shared->copy_page(PAGE, m_local);
+			m_numCopied.fetch_add(1, std::memory_order_release);
+			m_bCopied[PAGE].store(true, std::memory_order_release);
+		}
+	};
+}
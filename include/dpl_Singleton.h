@@ -4,6 +4,9 @@
 #include "dpl_GeneralException.h" // TODO: remove
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <mutex>
 #include <any>
 
 
@@ -20,7 +23,11 @@ namespace dpl
 namespace dpl
 {
 	/*
-		This class acts as a context for all singleton types.
+		This class acts as a context for all singleton types(world).
+		Singletons are resolved through thread-local pointers, so many worlds can coexist and run in parallel,
+		as long as each thread works with the world it is bound to.
+		Registering a singleton binds its world to the calling thread, unless the thread is already bound to another world.
+		Use bind() to switch the world of the calling thread(ThreadPool workers rebind automatically to the world of the thread that added the task).
 	*/
 	class Multition
 	{
@@ -28,11 +35,36 @@ namespace dpl
 		template<typename>
 		friend class Singleton;
 
+	private: // subtypes
+		using	Binder		= void(*)(void*); //<-- Assigns given instance to the thread-local pointer of the singleton type.
+
+		struct	Entry
+		{
+			void*	instance;
+			Binder	binder;
+		};
+
 	private: // data
-		std::unordered_map<std::type_index, void*> m_singletonTypes;
+		mutable std::mutex							m_mtx; //<-- Guards m_singletonTypes, workers may bind while singletons are (un)registered.
+		std::unordered_map<std::type_index, Entry>	m_singletonTypes;
+		std::atomic<uint64_t>						m_version; //<-- Changes with every registered/unregistered singleton.
+
+		static inline std::atomic<uint64_t>			sm_nextVersion	= 0;
+		static inline thread_local Multition*		sm_current		= nullptr;
+		static inline thread_local uint64_t			sm_boundVersion	= 0;
+		static inline thread_local std::vector<Binder>	sm_boundBinders;
 
 	public: // lifecycle
-		CLASS_CTOR		Multition() = default;
+		CLASS_CTOR		Multition()
+			: m_version(++sm_nextVersion)
+		{
+
+		}
+
+		CLASS_DTOR		~Multition()
+		{
+			if(sm_current == this) unbind();
+		}
 
 	private: // lifecycle
 		CLASS_CTOR		Multition(			const Multition& OTHER) = delete;
@@ -40,33 +72,102 @@ namespace dpl
 		Multition&		operator=(			const Multition& OTHER) = delete;
 		Multition&		operator=(			Multition&&		other) = delete;
 
+	public: // functions
+		/*
+			Returns world bound to the calling thread or nullptr.
+		*/
+		static Multition*	current()
+		{
+			return sm_current;
+		}
+
+		bool			is_bound() const
+		{
+			return sm_current == this;
+		}
+
+		/*
+			Makes singletons of this world visible to the calling thread.
+			Does nothing if the world is already bound and no singleton was added/removed since then.
+		*/
+		void			bind()
+		{
+			if(sm_current == this && sm_boundVersion == m_version.load(std::memory_order_acquire)) return;
+			unbind();
+
+			std::lock_guard lk(m_mtx);
+			for(auto& [TYPE, ENTRY] : m_singletonTypes)
+			{
+				ENTRY.binder(ENTRY.instance);
+				sm_boundBinders.push_back(ENTRY.binder);
+			}
+			sm_current		= this;
+			sm_boundVersion	= m_version.load(std::memory_order_acquire); //<-- Changed only under the lock.
+		}
+
+		/*
+			Detaches calling thread from its current world.
+		*/
+		static void		unbind()
+		{
+			for(Binder binder : sm_boundBinders)
+			{
+				binder(nullptr);
+			}
+			sm_boundBinders.clear();
+			sm_current		= nullptr;
+			sm_boundVersion	= 0;
+		}
+
 	private: // functions
 		template<typename SingletonT>
 		void*			get()
 		{
+			std::lock_guard lk(m_mtx);
 			auto it = m_singletonTypes.find(typeid(SingletonT));
 			if (it == m_singletonTypes.end()) return nullptr;
-			return it->second;
+			return it->second.instance;
 		}
 
 		template<typename SingletonT>
-		void			register_instance(	SingletonT*		INSTANCE)
+		void			register_instance(	SingletonT*		INSTANCE,
+											Binder			binder)
 		{
-			if (!m_singletonTypes.emplace(typeid(SingletonT), INSTANCE).second)
+			uint64_t previousVersion	= 0;
+			uint64_t newVersion			= 0;
+			{std::lock_guard lk(m_mtx);
+				if (!m_singletonTypes.emplace(typeid(SingletonT), Entry{INSTANCE, binder}).second)
+				{
+					throw dpl::GeneralException(__FILE__, __LINE__, "Fail to register singleton. Given type already registered: ", typeid(SingletonT).name());
+				}
+
+				newVersion		= ++sm_nextVersion;
+				previousVersion	= m_version.exchange(newVersion);
+			}
+
+			if(sm_current == this && sm_boundVersion == previousVersion)
+			{
+				binder(INSTANCE);
+				sm_boundBinders.push_back(binder);
+				sm_boundVersion = newVersion;
+			}
+			else if(sm_current == nullptr)
 			{
-				throw dpl::GeneralException(__FILE__, __LINE__, "Fail to register singleton. Given type already registered: ", typeid(SingletonT).name());
+				bind();
 			}
 		}
 
 		template<typename SingletonT>
 		void			unregister_instance(SingletonT*		INSTANCE)
 		{
+			std::lock_guard lk(m_mtx);
 			auto it = m_singletonTypes.find(typeid(SingletonT));
 			if (it != m_singletonTypes.end())
 			{
-				if (it->second == INSTANCE)
+				if (it->second.instance == INSTANCE)
 				{
 					m_singletonTypes.erase(it);
+					m_version = ++sm_nextVersion;
 					return;
 				}
 			}
@@ -77,7 +178,35 @@ namespace dpl
 
 
 	/*
-		Assures that only one instance of the given type is created.
+		Binds the world to the calling thread until the end of the scope, then restores the previous binding (also when an exception is thrown).
+	*/
+	class ScopedWorld
+	{
+	private: // data
+		Multition* m_previous;
+
+	public: // lifecycle
+		CLASS_CTOR		ScopedWorld(		Multition&			world)
+			: m_previous(Multition::current())
+		{
+			world.bind();
+		}
+
+		CLASS_DTOR		~ScopedWorld()
+		{
+			if(m_previous)	m_previous->bind();
+			else			Multition::unbind();
+		}
+
+	private: // lifecycle
+		CLASS_CTOR		ScopedWorld(		const ScopedWorld&	OTHER) = delete;
+		ScopedWorld&	operator=(			const ScopedWorld&	OTHER) = delete;
+	};
+
+
+	/*
+		Assures that only one instance of the given type is created per world(Multition).
+		Instance is resolved through the thread-local pointer assigned when the world is bound to the thread.
 		Note: In case of the DLL, class T should synchronize its resources with the multition.
 
 		TODO: @at -rdynamic flag
@@ -85,16 +214,18 @@ namespace dpl
 	template<class T>
 	class Singleton
 	{
+	public: // friends
+		friend Multition;
+
 	private: // data
-		static Singleton*	sm_instance;
-		Multition*			m_owner;
+		static inline thread_local Singleton*	sm_instance = nullptr;
+		Multition*								m_owner;
 
 	protected: // lifecycle
 		CLASS_CTOR			Singleton(		Multition&			multition)
 			: m_owner(&multition)
 		{
-			multition.register_instance<T>(static_cast<T*>(this));
-			sm_instance = this;
+			multition.register_instance<T>(static_cast<T*>(this), &Singleton::bind_instance);
 		}
 
 		CLASS_DTOR			~Singleton()
@@ -104,7 +235,7 @@ namespace dpl
 				if (m_owner)
 				{
 					m_owner->unregister_instance<T>(static_cast<T*>(this));
-					sm_instance = nullptr;
+					if(sm_instance == this) sm_instance = nullptr;
 					m_owner		= nullptr;
 				}
 			});
@@ -143,8 +274,11 @@ namespace dpl
 		{
 			sm_instance = static_cast<Singleton<T>*>(multition.get<T>());
 		}
-	};
 
-	template<class T>
-	Singleton<T>*	Singleton<T>::sm_instance	= nullptr;
+	private: // functions
+		static void			bind_instance(	void*				instance)
+		{
+			sm_instance = static_cast<Singleton<T>*>(static_cast<T*>(instance));
+		}
+	};
 }
\ No newline at end of file
@@ -9,8 +9,10 @@
 #include "dpl_Variation.h"
 #include "dpl_Logger.h"
 
+#ifdef _MSC_VER
 #pragma warning( push )
 #pragma warning( disable : 26110) //<-- Solves "Caller failing to hold lock..." VS bug.
+#endif
 
 // declarations
 namespace dpl
@@ -53,7 +55,7 @@ namespace dpl
 		template<is_State T>
 		void				set_next_state(	const Invoke<T>&	INVOKE_STATE = nullptr)
 		{
-			Variant::get_variation().set_next_state<T>(INVOKE_STATE);
+			Variant::get_variation().template set_next_state<T>(INVOKE_STATE);
 		}
 
 	private:	// [INTERFACE]
@@ -366,4 +368,6 @@ namespace dpl
 	}
 }
 
-#pragma warning( pop ) 
\ No newline at end of file
+#ifdef _MSC_VER
+#pragma warning( pop ) 
+#endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 
 #include <atomic>
+#include <utility>
 #include "dpl_DynamicArray.h"
 #include "dpl_Membership.h"
 #include "dpl_Mask.h"
@@ -167,6 +168,11 @@ namespace dpl
 			return container.capacity();
 		}
 
+		void						reserve(					const uint32_t			NEW_CAPACITY)
+		{
+			container.reserve(NEW_CAPACITY);
+		}
+
 		/*
 			Modify returned array.
 			Warning! Returned pointer may be invalidated when transfer is updated or array is resized.
@@ -197,7 +203,7 @@ namespace dpl
 		void						read_each(					const InvokeConst&		INVOKE) const
 		{
 			read();
-			container.for_each(INVOKE);
+			std::as_const(container).for_each(INVOKE); //<-- Container is mutable.
 		}
 
 		/*
@@ -285,6 +291,26 @@ namespace dpl
 			return container.data();
 		}
 
+		/*
+			See@ DynamicArray::release_buffer
+		*/
+		dpl::Buffer<T>				release_buffer()
+		{
+			restore();
+			dpl::Buffer<T> released = container.release_buffer();
+			notify_modified_locally();
+			notify_resized();
+			return released;
+		}
+
+		void						adopt(						dpl::Buffer<T>&&		buffer,
+																const uint32_t			SIZE)
+		{
+			container.adopt(std::move(buffer), SIZE);
+			notify_modified_locally();
+			notify_resized();
+		}
+
 		void						destroy_all_elements()
 		{
 			container.clear();
@@ -339,18 +365,20 @@ namespace dpl
 		void						notify_modified_locally()
 		{
 			if(flags.at(MODIFIED_LOCALLY)) return;
-			if(!is_stream_ready()) return;
+			MyStream* stream = MyMemberBase::get_group(); //<-- Tested once, so the compiler does not see a path through the null stream.
+			if(!stream) return;
 			flags.set_at(MODIFIED_LOCALLY, true);
-			get_stream().request_flush();
+			stream->request_flush();
 		}
 
 		void						notify_resized()
 		{		
 			range->reset(0, container.size());
 			if(flags.at(RESIZED)) return;// Already marked as resized?
-			if(!is_stream_ready()) return;
+			MyStream* stream = MyMemberBase::get_group();
+			if(!stream) return;
 			flags.set_at(RESIZED, true);
-			get_stream().request_resize();
+			stream->request_resize();
 		}
 
 		void						set_modified_remotely()
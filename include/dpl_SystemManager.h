@@ -6,6 +6,10 @@
 #include <unordered_map>
 #include <functional>
 #include <atomic>
+#include <mutex>
+#include <typeindex>
+#include <exception>
+#include <algorithm>
 #include "dpl_Singleton.h"
 #include "dpl_ReadOnly.h"
 #include "dpl_Timer.h"
@@ -17,8 +21,10 @@
 #include "dpl_Variation.h"
 #include "dpl_ThreadPool.h"
 
+#ifdef _MSC_VER
 #pragma warning( push )
 #pragma warning( disable : 26495 )
+#endif
 
 // declarations
 namespace dpl
@@ -40,6 +46,28 @@ namespace dpl
 		using ParentSystem = void;
 	};
 
+	/*
+		Specialize to declare entity and component types read and written by the system(as dpl::TypeList, use dpl::TypeList<> for none).
+		Root systems run concurrently with other root systems whose access(including subsystems) does not conflict with theirs.
+		System without specialization is treated as accessing everything.
+	*/
+	template<typename SystemT>
+	struct	Access_of
+	{
+		using Reads		= void;
+		using Writes	= void;
+	};
+
+	/*
+		Specialize to prepare the type declared in Access_of before the root systems are updated concurrently(e.g. to create its storage).
+		Entity types are specialized by the EntityManager, other types do not need any preparation.
+	*/
+	template<typename T>
+	struct	Preparation_of
+	{
+		static void prepare() {}
+	};
+
 	template<typename T>
 	concept is_RootSystem	=  std::is_same_v<typename Dependency_of<T>::ParentSystem, T>
 							|| std::is_same_v<typename Dependency_of<T>::ParentSystem, void>
@@ -202,6 +230,104 @@ namespace dpl
 	};
 
 
+	/*
+		Types read and written by the system(see Access_of).
+	*/
+	class	SystemAccess
+	{
+	private:	// [SUBTYPES]
+		template<typename ListT>
+		struct	AccessedTypes
+		{
+			static void append(std::vector<std::type_index>& types) {}
+			static void prepare() {}
+		};
+
+		template<typename... Ts>
+		struct	AccessedTypes<dpl::TypeList<Ts...>>
+		{
+			static void append(std::vector<std::type_index>& types) 
+			{
+				(types.emplace_back(typeid(Ts)), ...);
+			}
+
+			static void prepare()
+			{
+				(Preparation_of<Ts>::prepare(), ...);
+			}
+		};
+
+	public:		// [DATA]
+		dpl::ReadOnly<std::vector<std::type_index>, SystemAccess>	reads;
+		dpl::ReadOnly<std::vector<std::type_index>, SystemAccess>	writes;
+		dpl::ReadOnly<bool,											SystemAccess>	bExclusive; //<-- Access undeclared.
+		dpl::ReadOnly<std::vector<void(*)()>,						SystemAccess>	preparations; //<-- Prepare the accessed types (see@ Preparation_of).
+
+	public:		// [LIFECYCLE]
+		CLASS_CTOR				SystemAccess()
+			: bExclusive(false)
+		{
+
+		}
+
+	public:		// [FUNCTIONS]
+		template<typename SystemT>
+		void					declare()
+		{
+			using MyAccess = Access_of<SystemT>;
+			bExclusive = std::is_void_v<typename MyAccess::Reads> && std::is_void_v<typename MyAccess::Writes>;
+			reads->clear();
+			writes->clear();
+			AccessedTypes<typename MyAccess::Reads>::append(*reads);
+			AccessedTypes<typename MyAccess::Writes>::append(*writes);
+			preparations->assign({&AccessedTypes<typename MyAccess::Reads>::prepare, &AccessedTypes<typename MyAccess::Writes>::prepare});
+			sort_unique(*reads);
+			sort_unique(*writes);
+		}
+
+		void					merge(			const SystemAccess&	OTHER)
+		{
+			bExclusive = bExclusive() || OTHER.bExclusive();
+			reads->insert(reads->end(), OTHER.reads().begin(), OTHER.reads().end());
+			writes->insert(writes->end(), OTHER.writes().begin(), OTHER.writes().end());
+			preparations->insert(preparations->end(), OTHER.preparations().begin(), OTHER.preparations().end());
+			sort_unique(*reads);
+			sort_unique(*writes);
+		}
+
+		bool					conflicts_with(	const SystemAccess&	OTHER) const
+		{
+			if(bExclusive() || OTHER.bExclusive())
+				return true;
+
+			return intersects(writes(), OTHER.writes()) 
+				|| intersects(writes(), OTHER.reads()) 
+				|| intersects(reads(), OTHER.writes());
+		}
+
+	private:	// [FUNCTIONS]
+		static void				sort_unique(	std::vector<std::type_index>&		types)
+		{
+			std::sort(types.begin(), types.end());
+			types.erase(std::unique(types.begin(), types.end()), types.end());
+		}
+
+		static bool				intersects(		const std::vector<std::type_index>& A,
+												const std::vector<std::type_index>& B)
+		{
+			auto itA = A.begin();
+			auto itB = B.begin();
+			while(itA != A.end() && itB != B.end())
+			{
+				if(*itA < *itB)			++itA;
+				else if(*itB < *itA)	++itB;
+				else					return true;
+			}
+			return false;
+		}
+	};
+
+
 	class	ISystem	: public dpl::Variant<SystemManager, ISystem>
 					, private dpl::Group<ISystem, ISystem>
 					, private dpl::Member<ISystem, ISystem>
@@ -237,6 +363,7 @@ namespace dpl
 		dpl::ReadOnly<std::string,	ISystem> name;
 		dpl::ReadOnly<uint64_t,		ISystem> updateCycle;
 		dpl::ReadOnly<dpl::Timer,	ISystem> updateTimer;
+		dpl::ReadOnly<SystemAccess,	ISystem> access; //<-- Declared by the system only(subsystems not included).
 
 	private:	// [LIFECYCLE]
 		CLASS_CTOR			ISystem(					const Binding&		BINDING,
@@ -285,6 +412,23 @@ namespace dpl
 			throw std::runtime_error("System failure");
 		}
 
+	private:	// [ACCESS]
+		template<typename SystemT>
+		void				declare_access()
+		{
+			access->declare<SystemT>();
+		}
+
+		// Access of the system and all of its subsystems.
+		void				collect_access(				SystemAccess&		result) const
+		{
+			result.merge(access());
+			MySubsystems::for_each_member([&](const ISystem& SUBSYSTEM)
+			{
+				SUBSYSTEM.collect_access(result);
+			});
+		}
+
 	private:	// [DIAGNOSTIC]
 		void				reset_diagnostic()
 		{
@@ -352,6 +496,7 @@ namespace dpl
 			updateTimer().is_started()? updateTimer->unpause() : updateTimer->start();
 			log_and_throw_on_exception([&]()
 			{
+				const AccessCaller CALLER(name().c_str()); //<-- Labels accesses of this system and of the tasks it adds.
 				on_update(phase);
 				MySubsystems::for_each_member([&](ISystem& subsystem)
 				{
@@ -385,12 +530,7 @@ namespace dpl
 		using	Binding = ISystem::Binding;
 
 	protected:	// [LIFECYCLE]
-		CLASS_CTOR		System(			const Binding&		BINDING)
-			: ISystem(BINDING, dpl::undecorate_type_name<SystemT>())
-			, MySingletonBase(SystemManager::ref().owner())
-		{
-
-		}
+		CLASS_CTOR		System(			const Binding&		BINDING); //<-- Defined after the SystemManager.
 
 		CLASS_CTOR		System(			const System&		OTHER)			= delete;
 		CLASS_CTOR		System(			System&&			other) noexcept = default;
@@ -409,6 +549,14 @@ namespace dpl
 		using	InstallationOrder	= dpl::Sequence<ISystem, INSTALLATION_ORDER_HASH>;
 		using	RootSystems			= dpl::Sequence<ISystem, SYSTEM_CATEGORY_HASH>;
 
+		// Root system in the dependency graph.
+		struct	SystemNode
+		{
+			ISystem*				system;
+			std::vector<uint32_t>	successors;			//<-- Later root systems with conflicting access.
+			uint32_t				numPredecessors;
+		};
+
 	public:		// [SUBTYPES]
 		class	Installer
 		{
@@ -435,20 +583,36 @@ namespace dpl
 		friend	Installer;
 		friend	InstallationOrder;
 		friend	RootSystems;
+
+	public:		// [CONSTANTS]
+		static constexpr uint32_t DEFAULT_MAX_CONCURRENT_SYSTEMS = 4;
 		
 	private:	// [DATA]
-		std::string			m_settingsFile;
-		dpl::Logger			m_logger;
-		dpl::ParallelPhase	m_phase; // All tasks must be done between system updates(call ThreadPool::wait when phase is done).
+		std::string										m_settingsFile;
+		dpl::Logger										m_logger;
+		dpl::ParallelPhase								m_phase; // All tasks must be done between system updates(call ThreadPool::wait when phase is done).
+		uint32_t										m_maxConcurrentSystems;
+		std::vector<SystemNode>							m_systemGraph;
+		std::unique_ptr<std::atomic<uint32_t>[]>		m_numPendingPredecessors;
+		std::atomic<uint32_t>							m_numPendingSystems;
+		std::vector<std::unique_ptr<dpl::ParallelPhase>>m_lanePhases;	//<-- Phases of concurrently updated systems, executed by the workers of m_phase(empty if the graph does not allow it).
+		std::mutex										m_laneMtx;		//<-- Guards m_freeLanes and m_readyNodes.
+		std::vector<dpl::ParallelPhase*>				m_freeLanes;
+		std::vector<uint32_t>							m_readyNodes;	//<-- Systems waiting for a free lane.
+		std::mutex										m_failureMtx;
+		std::exception_ptr								m_failure;		//<-- First exception thrown by a concurrently updated system.
 
 	protected:		// [LIFECYCLE]
 		CLASS_CTOR		SystemManager(			Multition&			multition,
 												const std::string&	SETTINGS_FILE,
-												const uint32_t		NUM_THREADS = std::thread::hardware_concurrency())
+												const uint32_t		NUM_THREADS				= std::thread::hardware_concurrency(),
+												const uint32_t		MAX_CONCURRENT_SYSTEMS	= DEFAULT_MAX_CONCURRENT_SYSTEMS)
 			: Singleton(multition)
 			, m_settingsFile(SETTINGS_FILE)
 			, m_logger(multition)
 			, m_phase(NUM_THREADS)
+			, m_maxConcurrentSystems(std::max(1u, MAX_CONCURRENT_SYSTEMS))
+			, m_numPendingSystems(0)
 		{
 
 		}
@@ -462,15 +626,49 @@ namespace dpl
 			Installer installer;
 			ON_INSTALL(installer);
 			SystemManager::load_settings();
+			SystemManager::build_system_graph();
 		}
 
+		/*
+			Root systems are updated in the installation order, unless their access declarations allow them to overlap.
+			Overlapping systems are updated by the workers of m_phase, the calling thread helps them until all systems are done.
+		*/
 		void			update_all_systems()
 		{
-			RootSystems::for_each([&](ISystem& system)
+			if(m_lanePhases.empty())
 			{
-				system.update(m_phase);
-				throw_if_phase_not_done();
+				RootSystems::for_each([&](ISystem& system)
+				{
+					system.update(m_phase);
+					throw_if_phase_not_done(m_phase);
+				});
+				return;
+			}
+
+			const uint32_t NUM_NODES = (uint32_t)m_systemGraph.size();
+			for(uint32_t nodeID = 0; nodeID < NUM_NODES; ++nodeID)
+			{
+				m_numPendingPredecessors[nodeID].store(m_systemGraph[nodeID].numPredecessors, std::memory_order_relaxed);
+			}
+			m_numPendingSystems.store(NUM_NODES, std::memory_order_relaxed);
+
+			for(uint32_t nodeID = 0; nodeID < NUM_NODES; ++nodeID)
+			{
+				if(m_systemGraph[nodeID].numPredecessors == 0)
+					schedule_system_node(nodeID);
+			}
+
+			m_phase.help_until([&]()
+			{
+				return m_numPendingSystems.load(std::memory_order_acquire) == 0;
 			});
+
+			if(m_failure)
+			{
+				std::exception_ptr failure = nullptr;
+				std::swap(failure, m_failure);
+				std::rethrow_exception(failure);
+			}
 		}
 
 		void			uninstall_all_systems()
@@ -481,6 +679,7 @@ namespace dpl
 			{
 				system.uninstall();
 			});
+			SystemManager::clear_system_graph();
 			Variation::destroy_all_variants();
 		}
 
@@ -506,6 +705,129 @@ namespace dpl
 			return true;
 		}
 
+	private:	// [SYSTEM GRAPH]
+		/*
+			Root system depends on every earlier root system with conflicting access(including subsystems).
+			Concurrent update is enabled only if the widest level of the graph has more than one system.
+			Declared types are prepared first, so that the systems do not create entity packs concurrently.
+		*/
+		void			build_system_graph()
+		{
+			clear_system_graph();
+
+			std::vector<SystemAccess> accesses;
+			RootSystems::for_each([&](ISystem& system)
+			{
+				m_systemGraph.push_back(SystemNode{&system, {}, 0});
+				system.collect_access(accesses.emplace_back());
+			});
+
+			const uint32_t			NUM_NODES = (uint32_t)m_systemGraph.size();
+			std::vector<uint32_t>	levels(NUM_NODES, 0);
+			std::vector<uint32_t>	levelWidths(NUM_NODES, 0);
+			uint32_t				maxWidth = 0;
+
+			for(uint32_t nodeID = 0; nodeID < NUM_NODES; ++nodeID)
+			{
+				for(uint32_t prevID = 0; prevID < nodeID; ++prevID)
+				{
+					if(accesses[prevID].conflicts_with(accesses[nodeID]))
+					{
+						m_systemGraph[prevID].successors.push_back(nodeID);
+						++m_systemGraph[nodeID].numPredecessors;
+						levels[nodeID] = std::max(levels[nodeID], levels[prevID] + 1);
+					}
+				}
+				maxWidth = std::max(maxWidth, ++levelWidths[levels[nodeID]]);
+			}
+
+			const uint32_t NUM_LANES = std::min(maxWidth, m_maxConcurrentSystems);
+			if(NUM_LANES <= 1)
+				return;
+
+			for(const SystemAccess& ACCESS : accesses)
+			{
+				for(void (*prepare)() : ACCESS.preparations()) prepare();
+			}
+
+			m_numPendingPredecessors.reset(new std::atomic<uint32_t>[NUM_NODES]);
+			for(uint32_t laneID = 0; laneID < NUM_LANES; ++laneID)
+			{
+				m_freeLanes.push_back(m_lanePhases.emplace_back(std::make_unique<dpl::ParallelPhase>(m_phase)).get()); //<-- No threads of its own.
+			}
+
+			m_logger.push_info("Root systems: %d, concurrently updated: up to %d", NUM_NODES, NUM_LANES);
+		}
+
+		void			clear_system_graph()
+		{
+			m_systemGraph.clear();
+			m_numPendingPredecessors.reset();
+			m_freeLanes.clear();
+			m_readyNodes.clear();
+			m_lanePhases.clear();
+		}
+
+		// Updates the system on a free lane, or queues it until one is released.
+		void			schedule_system_node(	const uint32_t		NODE_ID)
+		{
+			dpl::ParallelPhase* lane = nullptr;
+			{std::lock_guard lk(m_laneMtx);
+				if(m_freeLanes.empty())
+				{
+					m_readyNodes.push_back(NODE_ID);
+					return;
+				}
+				lane = m_freeLanes.back();
+				m_freeLanes.pop_back();
+			}
+
+			m_phase.post([this, NODE_ID, lane](){ update_system_node(NODE_ID, *lane); });
+		}
+
+		// Passes the LANE to the system that waits for it, or frees it.
+		void			release_lane(			dpl::ParallelPhase&	lane)
+		{
+			uint32_t waitingID = 0;
+			{std::lock_guard lk(m_laneMtx);
+				if(m_readyNodes.empty())
+				{
+					m_freeLanes.push_back(&lane);
+					return;
+				}
+				waitingID = m_readyNodes.back();
+				m_readyNodes.pop_back();
+			}
+
+			m_phase.post([this, waitingID, &lane](){ update_system_node(waitingID, lane); });
+		}
+
+		void			update_system_node(		const uint32_t		NODE_ID,
+												dpl::ParallelPhase&	lane)
+		{
+			const SystemNode& NODE = m_systemGraph[NODE_ID];
+			try
+			{
+				NODE.system->update(lane);
+				throw_if_phase_not_done(lane);
+			}
+			catch(...)
+			{
+				std::lock_guard lk(m_failureMtx);
+				if(!m_failure) m_failure = std::current_exception();
+			}
+
+			release_lane(lane);
+
+			for(const uint32_t SUCCESSOR_ID : NODE.successors)
+			{
+				if(m_numPendingPredecessors[SUCCESSOR_ID].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					schedule_system_node(SUCCESSOR_ID);
+			}
+
+			m_numPendingSystems.fetch_sub(1, std::memory_order_acq_rel); //<-- Last access, the caller of update_all_systems may return after it.
+		}
+
 	private:	// [FUNCTIONS]
 		template<typename SystemT>
 		void			install_system()
@@ -547,14 +869,25 @@ namespace dpl
 				throw dpl::GeneralException(this, __LINE__, "Systems already installed.");
 		}
 
-		void			throw_if_phase_not_done() const
+		void			throw_if_phase_not_done(const dpl::ParallelPhase&	PHASE) const
 		{
 #ifdef _DEBUG
-			if(m_phase.numTasks() > 0)
+			if(PHASE.numTasks() > 0)
 				throw dpl::GeneralException(this, __LINE__, "Parallel phase not done.");
 #endif // _DEBUG
 		}
 	};
+
+
+	template<typename SystemT>
+	inline System<SystemT>::System(	const Binding&		BINDING)
+		: ISystem(BINDING, dpl::undecorate_type_name<SystemT>())
+		, MySingletonBase(SystemManager::ref().owner())
+	{
+		ISystem::declare_access<SystemT>();
+	}
 }
 
-#pragma warning( pop )
\ No newline at end of file
+#ifdef _MSC_VER
+#pragma warning( pop )
+#endif
\ No newline at end of file
@@ -0,0 +1,472 @@
+#pragma once
+
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "dpl_ThreadPool.h"
+
+
+namespace dpl
+{
+	template<typename T>
+	class	Task;
+
+	namespace Coroutine
+	{
+		/*
+			Resumes the coroutine that awaits the finished one.
+		*/
+		struct	FinalAwaiter
+		{
+			bool					await_ready() noexcept
+			{
+				return false;
+			}
+
+			template<typename PromiseT>
+			std::coroutine_handle<>	await_suspend(	std::coroutine_handle<PromiseT>	handle) noexcept
+			{
+				auto& promise	= handle.promise();
+				void* next		= promise.continuation.exchange(&promise, std::memory_order_acq_rel);
+				promise.release(handle); //<-- Frame may be destroyed from here.
+				return next? std::coroutine_handle<>::from_address(next) : std::noop_coroutine();
+			}
+
+			void					await_resume() noexcept
+			{
+
+			}
+		};
+
+		/*
+			State shared by promises of all Task types.
+			Frame is destroyed by whichever comes last: the coroutine reaching its end, or the Task handle being released.
+		*/
+		class	PromiseBase
+		{
+		public: // data
+			ThreadPool*				pool;			//<-- Pool that resumes the coroutine after it was suspended(inherited by awaited tasks).
+			std::exception_ptr		exception;
+			std::atomic<void*>		continuation;	//<-- Coroutine awaiting this one, or address of this promise when done.
+			std::atomic<uint32_t>	numRefs;
+			std::atomic<bool>		bStarted;
+
+		public: // lifecycle
+			CLASS_CTOR				PromiseBase()
+				: pool(nullptr)
+				, continuation(nullptr)
+				, numRefs(2) //<-- Handle and the running coroutine.
+				, bStarted(false)
+			{
+
+			}
+
+		public: // functions
+			std::suspend_always		initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			FinalAwaiter			final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void					unhandled_exception() noexcept
+			{
+				exception = std::current_exception();
+			}
+
+			bool					is_done() const
+			{
+				return continuation.load(std::memory_order_acquire) == this;
+			}
+
+			template<typename PromiseT>
+			void					release(std::coroutine_handle<PromiseT> handle) noexcept
+			{
+				if(numRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					handle.destroy();
+			}
+		};
+
+		template<typename T>
+		class	Promise : public PromiseBase
+		{
+		public: // data
+			std::optional<T>	value;
+
+		public: // functions
+			Task<T>				get_return_object() noexcept;
+
+			template<typename U>
+			void				return_value(	U&&		result)
+			{
+				value.emplace(std::forward<U>(result));
+			}
+
+			T					take_result()
+			{
+				if(exception) std::rethrow_exception(exception);
+				return std::move(*value);
+			}
+		};
+
+		template<>
+		class	Promise<void> : public PromiseBase
+		{
+		public: // functions
+			Task<void>			get_return_object() noexcept;
+
+			void				return_void() noexcept
+			{
+
+			}
+
+			void				take_result()
+			{
+				if(exception) std::rethrow_exception(exception);
+			}
+		};
+
+		/*
+			Queues the coroutine to the pool(or resumes it in place if there is none).
+		*/
+		inline void				resume_in(		ThreadPool*					pool,
+												std::coroutine_handle<>		handle)
+		{
+			if(pool)	pool->add_task([handle](){ handle.resume(); });
+			else		handle.resume();
+		}
+	}
+
+
+	/*
+		Lazy coroutine scheduled on the ThreadPool.
+		It does not run until it is started on a pool or awaited by another coroutine(that runs it in place).
+		Awaiting suspends the coroutine without blocking the worker, it is resumed by the thread that finishes the awaited work.
+
+		Example:
+			dpl::Task<Mesh> load_mesh(std::string path)
+			{
+				Bytes	bytes	= co_await read_file(path);
+				Mesh	mesh	= decode(bytes);
+				co_await dpl::next_cycle(); //<-- Main thread, see: dpl_Application.h
+				register_mesh(mesh);
+				co_return mesh;
+			}
+
+			Task<Mesh> task = load_mesh("tree.mesh");
+			task.start(pool);
+			...
+			if(task.is_done()) Mesh mesh = task.get();
+	*/
+	template<typename T = void>
+	class	Task
+	{
+	public: // subtypes
+		using	promise_type	= Coroutine::Promise<T>;
+		using	Handle			= std::coroutine_handle<promise_type>;
+
+	private: // subtypes
+		struct	Awaiter
+		{
+			Handle	handle;
+
+			bool					await_ready() const noexcept
+			{
+				return handle.promise().is_done();
+			}
+
+			template<typename PromiseT>
+			std::coroutine_handle<>	await_suspend(std::coroutine_handle<PromiseT> awaiting) noexcept
+			{
+				promise_type& promise = handle.promise();
+				if(!promise.bStarted.exchange(true, std::memory_order_acq_rel))
+				{
+					promise.pool = awaiting.promise().pool;
+					promise.continuation.store(awaiting.address(), std::memory_order_relaxed);
+					return handle; //<-- Runs the awaited task in place.
+				}
+
+				void* expected = nullptr;
+				if(promise.continuation.compare_exchange_strong(expected, awaiting.address(), std::memory_order_acq_rel))
+					return std::noop_coroutine(); //<-- Resumed by the thread that finishes the task.
+
+				return awaiting; //<-- Finished in the meantime.
+			}
+
+			T						await_resume()
+			{
+				return handle.promise().take_result();
+			}
+		};
+
+	private: // data
+		Handle	m_handle;
+
+	public: // lifecycle
+		CLASS_CTOR		Task() noexcept
+			: m_handle(nullptr)
+		{
+
+		}
+
+		CLASS_CTOR		Task(		Handle		handle) noexcept
+			: m_handle(handle)
+		{
+
+		}
+
+		CLASS_CTOR		Task(		const Task&	OTHER) = delete;
+
+		CLASS_CTOR		Task(		Task&&		other) noexcept
+			: m_handle(std::exchange(other.m_handle, nullptr))
+		{
+
+		}
+
+		CLASS_DTOR		~Task()
+		{
+			release();
+		}
+
+		Task&			operator=(	const Task&	OTHER) = delete;
+
+		Task&			operator=(	Task&&		other) noexcept
+		{
+			if(this != &other)
+			{
+				release();
+				m_handle = std::exchange(other.m_handle, nullptr);
+			}
+			return *this;
+		}
+
+	public: // functions
+		bool			valid() const
+		{
+			return m_handle != nullptr;
+		}
+
+		bool			is_done() const
+		{
+			return m_handle && m_handle.promise().is_done();
+		}
+
+		/*
+			Queues the coroutine to the POOL, which also resumes it after each suspension.
+		*/
+		void			start(		ThreadPool&	pool)
+		{
+			if(!m_handle)
+				throw dpl::GeneralException(this, __LINE__, "Task is empty.");
+
+			promise_type& promise = m_handle.promise();
+			if(promise.bStarted.exchange(true, std::memory_order_acq_rel))
+				throw dpl::GeneralException(this, __LINE__, "Task was already started.");
+
+			promise.pool = &pool;
+			Coroutine::resume_in(&pool, m_handle);
+		}
+
+		/*
+			Returns the result of the finished task(once), or rethrows its exception.
+		*/
+		T				get()
+		{
+			if(!is_done())
+				throw dpl::GeneralException(this, __LINE__, "Task is not finished.");
+
+			return m_handle.promise().take_result();
+		}
+
+		Awaiter			operator co_await() && noexcept
+		{
+			return Awaiter{m_handle};
+		}
+
+		Awaiter			operator co_await() & noexcept
+		{
+			return Awaiter{m_handle};
+		}
+
+	private: // functions
+		void			release() noexcept
+		{
+			if(!m_handle)
+				return;
+
+			promise_type& promise = m_handle.promise();
+			if(!promise.bStarted.exchange(true, std::memory_order_acq_rel))
+			{
+				m_handle.destroy(); //<-- Never started, nothing else refers to the frame.
+			}
+			else
+			{
+				promise.release(m_handle);
+			}
+			m_handle = nullptr;
+		}
+	};
+
+
+	namespace Coroutine
+	{
+		template<typename T>
+		Task<T>		Promise<T>::get_return_object() noexcept
+		{
+			return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> Promise<void>::get_return_object() noexcept
+		{
+			return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+		}
+	}
+
+
+	/*
+		Coroutines waiting for the thread that owns the queue(e.g. main thread of the Application).
+	*/
+	class	ResumeQueue
+	{
+	private: // data
+		std::mutex							m_mtx;
+		std::vector<std::coroutine_handle<>> m_queued;
+		std::vector<std::coroutine_handle<>> m_resumed;
+
+	public: // functions
+		void			push(			std::coroutine_handle<>		handle)
+		{
+			std::lock_guard lk(m_mtx);
+			m_queued.push_back(handle);
+		}
+
+		/*
+			Resumes coroutines queued before the call, the ones queued during the call wait for the next one.
+			Coroutines that are still queued when the queue is destroyed are never resumed.
+		*/
+		void			resume_all()
+		{
+			{std::lock_guard lk(m_mtx);
+				m_resumed.swap(m_queued);
+			}
+
+			for(auto handle : m_resumed)
+			{
+				handle.resume();
+			}
+			m_resumed.clear();
+		}
+	};
+
+
+	namespace Coroutine
+	{
+		struct	PoolAwaiter
+		{
+			ThreadPool& pool;
+
+			bool			await_ready() const noexcept
+			{
+				return false;
+			}
+
+			template<typename PromiseT>
+			void			await_suspend(	std::coroutine_handle<PromiseT>	handle)
+			{
+				if constexpr (std::is_base_of_v<PromiseBase, PromiseT>)
+					handle.promise().pool = &pool;
+
+				resume_in(&pool, handle);
+			}
+
+			void			await_resume() noexcept
+			{
+
+			}
+		};
+
+		struct	QueueAwaiter
+		{
+			ResumeQueue& queue;
+
+			bool			await_ready() const noexcept
+			{
+				return false;
+			}
+
+			void			await_suspend(	std::coroutine_handle<>			handle)
+			{
+				queue.push(handle);
+			}
+
+			void			await_resume() noexcept
+			{
+
+			}
+		};
+
+		struct	PhaseAwaiter
+		{
+			ParallelPhase& phase;
+
+			bool			await_ready() const noexcept
+			{
+				return false;
+			}
+
+			template<typename PromiseT>
+			void			await_suspend(	std::coroutine_handle<PromiseT>	handle)
+			{
+				ThreadPool* pool = nullptr;
+				if constexpr (std::is_base_of_v<PromiseBase, PromiseT>)
+					pool = handle.promise().pool;
+
+				phase.start_async([pool, handle]()
+				{
+					resume_in(pool, handle);
+				});
+			}
+
+			void			await_resume()
+			{
+				phase.flush_errors(); //<-- Throws the first error in the coroutine.
+			}
+		};
+	}
+
+
+	/*
+		co_await resume_on(pool) continues the coroutine on the worker of the POOL,
+		which also resumes the coroutine after the following suspensions.
+	*/
+	inline Coroutine::PoolAwaiter	resume_on(			ThreadPool&		pool)
+	{
+		return {pool};
+	}
+
+	/*
+		co_await resume_on(queue) continues the coroutine on the thread that calls queue.resume_all().
+	*/
+	inline Coroutine::QueueAwaiter	resume_on(			ResumeQueue&	queue)
+	{
+		return {queue};
+	}
+
+	/*
+		co_await phase starts it asynchronously(see: ParallelPhase::start_async),
+		the coroutine is resumed on its pool when the phase is done. Errors of the phase are thrown in the coroutine.
+		Coroutine without a pool is resumed by the worker that finished the phase, so it must not start
+		the PERSISTENT phase synchronously until it moves elsewhere(e.g. co_await resume_on(pool)).
+	*/
+	inline Coroutine::PhaseAwaiter	operator co_await(	ParallelPhase&	phase)
+	{
+		return {phase};
+	}
+}
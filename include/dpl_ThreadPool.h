@@ -1,7 +1,10 @@
 #pragma once
 
 
-#include <queue>
+#include <deque>
+#include <atomic>
+#include <random>
+#include <algorithm>
 #include <vector>
 #include <condition_variable>
 #include <future>
@@ -9,13 +12,23 @@
 #include <thread>
 #include <memory>
 #include <mutex>
+#include <limits>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 #include "dpl_ReadOnly.h"
 #include "dpl_DynamicArray.h"
 #include "dpl_Logger.h"
+#include "dpl_GeneralException.h"
+#include "dpl_InplaceTask.h"
+#include "dpl_PoolAllocator.h"
+#include "dpl_AccessTracker.h"
 
 
+#ifdef _MSC_VER
 #pragma warning(disable : 26812)
 #pragma warning(disable : 6385)
+#endif
 
 namespace dpl
 {
@@ -31,8 +44,173 @@ namespace dpl
 			static const auto NOW = std::chrono::system_clock::time_point::min();
 			return future.wait_until(NOW) == std::future_status::ready;
 		}
+
+		/*
+			Hints the CPU that the calling thread is in a spin-wait loop.
+		*/
+		inline void pause()
+		{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+			_mm_pause();
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+			asm volatile("yield");
+#else
+			std::this_thread::yield();
+#endif
+		}
 	}
 
+	/*
+		Chase-Lev work-stealing deque(see: Le, Pop, Cohen, Zappa Nardelli - "Correct and Efficient Work-Stealing for Weak Memory Models").
+		Only the owner thread may push/pop at the bottom, any thread may steal from the top.
+		Buffers replaced on growth are kept until destruction, because thieves may still read from them.
+	*/
+	template<typename T>
+	class WorkStealingDeque
+	{
+	private: // subtypes
+		class	Buffer
+		{
+		private: // data
+			int64_t								m_capacity; //<-- Always power of 2.
+			std::unique_ptr<std::atomic<T>[]>	m_slots;
+
+		public: // lifecycle
+			CLASS_CTOR		Buffer(		const int64_t	CAPACITY)
+				: m_capacity(CAPACITY)
+				, m_slots(new std::atomic<T>[CAPACITY])
+			{
+
+			}
+
+		public: // functions
+			int64_t			capacity() const
+			{
+				return m_capacity;
+			}
+
+			T				get(		const int64_t	INDEX) const
+			{
+				return m_slots[INDEX & (m_capacity - 1)].load(std::memory_order_relaxed);
+			}
+
+			void			put(		const int64_t	INDEX,
+										T				item)
+			{
+				m_slots[INDEX & (m_capacity - 1)].store(item, std::memory_order_relaxed);
+			}
+
+			Buffer*			grow(		const int64_t	BOTTOM,
+										const int64_t	TOP) const
+			{
+				Buffer* buffer = new Buffer(2 * m_capacity);
+				for(int64_t index = TOP; index < BOTTOM; ++index)
+				{
+					buffer->put(index, get(index));
+				}
+				return buffer;
+			}
+		};
+
+	private: // data
+		alignas(64) std::atomic<int64_t>		m_top;
+		alignas(64) std::atomic<int64_t>		m_bottom;
+		std::atomic<Buffer*>					m_buffer;
+		std::vector<std::unique_ptr<Buffer>>	m_buffers; //<-- Owns current and all retired buffers.
+
+	public: // lifecycle
+		CLASS_CTOR		WorkStealingDeque(	const int64_t	INITIAL_CAPACITY = 256)
+			: m_top(0)
+			, m_bottom(0)
+		{
+			m_buffers.emplace_back(new Buffer(INITIAL_CAPACITY));
+			m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+		}
+
+		CLASS_CTOR		WorkStealingDeque(	const WorkStealingDeque& OTHER) = delete;
+
+		WorkStealingDeque& operator=(		const WorkStealingDeque& OTHER) = delete;
+
+	public: // functions
+		/*
+			Approximation, may be outdated by the time it returns.
+		*/
+		bool			empty() const
+		{
+			const int64_t BOTTOM	= m_bottom.load(std::memory_order_relaxed);
+			const int64_t TOP		= m_top.load(std::memory_order_relaxed);
+			return BOTTOM <= TOP;
+		}
+
+		// Owner only.
+		void			push(				T				item)
+		{
+			const int64_t	BOTTOM	= m_bottom.load(std::memory_order_relaxed);
+			const int64_t	TOP		= m_top.load(std::memory_order_acquire);
+			Buffer*			buffer	= m_buffer.load(std::memory_order_relaxed);
+
+			if(BOTTOM - TOP > buffer->capacity() - 1)
+			{
+				buffer = buffer->grow(BOTTOM, TOP);
+				m_buffers.emplace_back(buffer);
+				m_buffer.store(buffer, std::memory_order_release);
+			}
+
+			buffer->put(BOTTOM, item);
+			m_bottom.store(BOTTOM + 1, std::memory_order_release); //<-- Publishes the item(and the recycled node it points to) to thieves.
+		}
+
+		// Owner only. Returns nullptr if empty.
+		T				pop()
+		{
+			const int64_t	BOTTOM	= m_bottom.load(std::memory_order_relaxed) - 1;
+			Buffer*			buffer	= m_buffer.load(std::memory_order_relaxed);
+			m_bottom.store(BOTTOM, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t			top		= m_top.load(std::memory_order_relaxed);
+
+			if(top > BOTTOM)
+			{
+				m_bottom.store(BOTTOM + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T item = buffer->get(BOTTOM);
+			if(top == BOTTOM) // Last item, race against thieves.
+			{
+				if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+
+				m_bottom.store(BOTTOM + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+		// Any thread. Returns nullptr if empty or if another thread won the race.
+		T				steal()
+		{
+			int64_t			top		= m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t	BOTTOM	= m_bottom.load(std::memory_order_acquire);
+
+			if(top >= BOTTOM) 
+				return nullptr;
+
+			Buffer*	buffer	= m_buffer.load(std::memory_order_acquire);
+			T		item	= buffer->get(top);
+			if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+	};
+
+	/*
+		Work-stealing thread pool.
+		Each worker owns a WorkStealingDeque: tasks added by a worker go to its own deque(LIFO for the owner), 
+		tasks added by other threads go to the shared injection queue.
+		Idle workers steal from random victims, then back off exponentially(pause -> yield) before parking.
+	*/
 	class ThreadPool
 	{
 	public: // subtypes
@@ -52,26 +230,71 @@ namespace dpl
 			}
 		};
 
-		using	Task			= std::function<void()>;
+		using	Task			= InplaceTask<>;	//<-- Move-only, small callables are stored without allocation.
 		using	NativeHandle	= std::thread::native_handle_type;
 		using	ErrorCallback	= std::function<void(const Error&)>;
 
+	private: // subtypes
+		struct	QueuedTask
+		{
+			Task		task;
+			Multition*	world; //<-- World bound to the thread that added the task.
+			const char*	caller; //<-- Access caller of the thread that added the task (see@ AccessCaller).
+		};
+
+		struct	alignas(64) Worker
+		{
+			ThreadPool*						pool;
+			uint32_t						ID;
+			std::minstd_rand				random; //<-- Victim selection.
+			WorkStealingDeque<QueuedTask*>	deque;
+			std::vector<QueuedTask*>		freeTasks; //<-- Recycled nodes, accessed by the owner only.
+
+			CLASS_CTOR Worker(	ThreadPool*		POOL,
+								const uint32_t	WORKER_ID)
+				: pool(POOL)
+				, ID(WORKER_ID)
+				, random(WORKER_ID + 1)
+			{
+
+			}
+		};
+
+	public: // constants
+		static constexpr uint32_t	MAIN_THREAD_ID		= std::numeric_limits<uint32_t>::max(); //<-- Reported in errors of tasks executed by the waiting thread.
+
+	private: // constants
+		static constexpr uint32_t	NUM_SPIN_ROUNDS		= 6;	//<-- Pause 1, 2, 4, ... 32 times between attempts to find a task.
+		static constexpr uint32_t	NUM_YIELD_ROUNDS	= 4;	//<-- Then yield between attempts, then park.
+		static constexpr size_t		MAX_INJECTED_BATCH	= 32;	//<-- Max number of injected tasks moved at once to the worker deque.
+		static constexpr size_t		MAX_FREE_TASKS		= 256;	//<-- Worker returns half of its recycled nodes to the shared list above this limit.
+
 	private: // data
-		mutable std::mutex			m_mtx;
-		std::thread::id				m_mainThreadID;
-		std::condition_variable		m_finished; // Notifies when worker finishes the task.
-		std::condition_variable		m_order;	// Notifies when there is a job to do, or when thread pool needs to terminate.
-		std::queue<Task>			m_tasks;
-		std::vector<Error>			m_errors;
-		size_t						m_numTasks; // Number of tasks in the queue + number of tasks performed by workers
-		size_t						m_numWorkers;
-		bool						bTerminate;
+		std::vector<std::unique_ptr<Worker>>	m_workers;
+		std::vector<std::thread>				m_threads;
+		std::mutex								m_injectedMtx;
+		std::deque<QueuedTask*>					m_injected;		// Tasks added by threads that are not workers of this pool.
+		std::vector<QueuedTask*>				m_freeTasks;	// Recycled nodes shared between threads, guarded by m_injectedMtx.
+		alignas(64) std::atomic<size_t>			m_numQueued;	// Number of tasks in the deques + injection queue.
+		alignas(64) std::atomic<size_t>			m_numTasks;		// Number of queued tasks + number of tasks performed by workers.
+		std::atomic<size_t>						m_numWorkers;
+		std::atomic<uint32_t>					m_numParked;
+		std::atomic<bool>						bTerminate;
+		std::mutex								m_parkMtx;
+		std::condition_variable					m_order;		// Notifies when there is a job to do, or when thread pool needs to terminate.
+		std::minstd_rand						m_random;		// Victim selection of the waiting thread.
+		mutable std::mutex						m_mtx;			// Guards errors and m_finished.
+		std::condition_variable					m_finished;		// Notifies when last task is done.
+		std::vector<Error>						m_errors;
+
+		static inline thread_local Worker*		sm_worker = nullptr;
 
 	public: // lifecycle
 		CLASS_CTOR						ThreadPool(							const uint32_t			NUM_THREADS = std::thread::hardware_concurrency())
-			: m_mainThreadID(std::this_thread::get_id())
+			: m_numQueued(0)
 			, m_numTasks(0)
 			, m_numWorkers(0)
+			, m_numParked(0)
 			, bTerminate(false)
 		{
 			start(NUM_THREADS);
@@ -93,29 +316,41 @@ namespace dpl
 	public: // functions
 		size_t							get_numWorkers() const
 		{
-			std::lock_guard<std::mutex> lk(m_mtx);
-			return m_numWorkers;
+			return m_numWorkers.load(std::memory_order_acquire);
 		}
 
 		size_t							get_numTasks() const
 		{
-			std::lock_guard<std::mutex> lk(m_mtx);
-			return m_numTasks;
+			return m_numTasks.load(std::memory_order_acquire);
 		}
 
 		void							add_task(							Task					task)
 		{
-			{std::lock_guard lk(m_mtx);
-				m_tasks.emplace(std::move(task));
-				++m_numTasks;
+			m_numTasks.fetch_add(1, std::memory_order_seq_cst);
+			m_numQueued.fetch_add(1, std::memory_order_seq_cst); //<-- Before push, so that the counter never underflows.
+
+			if(sm_worker && sm_worker->pool == this)
+			{
+				if(sm_worker->freeTasks.empty())
+				{
+					std::lock_guard lk(m_injectedMtx);
+					move_free_tasks(m_freeTasks, sm_worker->freeTasks, MAX_FREE_TASKS / 2);
+				}
+
+				sm_worker->deque.push(make_queued(sm_worker->freeTasks, std::move(task)));
+			}
+			else
+			{
+				std::lock_guard lk(m_injectedMtx);
+				m_injected.push_back(make_queued(m_freeTasks, std::move(task)));
 			}
 
-			m_order.notify_one();
+			wake_worker();
 		}
 
 		/*
 			Creates new task and adds it to the queue.
-			Returns std::future.
+			Returns std::future, its shared state is taken from the BlockPool.
 
 			For member function use:
 				create_task(&Class::method, &Obj, args...);
@@ -129,41 +364,63 @@ namespace dpl
 			/// Using a conditional wrapper to avoid dangling references.
 			/// Courtesy of https://stackoverflow.com/a/46565491/4639195.
 			
-			auto task = std::make_shared<std::packaged_task<ret_t()>>(std::bind(std::forward<F>(function), wrap(std::forward<Args>(args))...));
+			std::promise<ret_t> promise(std::allocator_arg, PoolAllocator<ret_t>());
+			std::future<ret_t> result(promise.get_future());
 
-			std::future<ret_t> result(task->get_future());
-
-			add_task([=] { (*task)(); });
+			add_task([promise = std::move(promise), call = std::bind(std::forward<F>(function), wrap(std::forward<Args>(args))...)]() mutable
+			{
+				try
+				{
+					if constexpr (std::is_void_v<ret_t>)
+					{
+						call();
+						promise.set_value();
+					}
+					else
+					{
+						promise.set_value(call());
+					}
+				}
+				catch(...)
+				{
+					promise.set_exception(std::current_exception());
+				}
+			});
 			return result;
 		}
 
 		void							wait(								const ErrorCallback&	ERROR_CALLBACK = &log_and_throw_first_worker_error)
 		{
 #ifdef _DEBUG
-			if(std::this_thread::get_id() != m_mainThreadID)
-				push_error(std::numeric_limits<uint32_t>::max(), "ThreadPool::wait must be called in the main thread.");
+			if(sm_worker && sm_worker->pool == this)
+				push_error(MAIN_THREAD_ID, "ThreadPool::wait must not be called by the worker of the same pool.");
 #endif // _DEBUG
 
+			help_while_waiting();
+
 			std::unique_lock lk(m_mtx);
 
-			if(m_numTasks > 0)
+			if(m_numTasks.load(std::memory_order_acquire) > 0)
 			{
 				m_finished.wait(lk, [&] 
 				{
-					return m_numTasks == 0 || bTerminate;
+					return m_numTasks.load(std::memory_order_acquire) == 0 || bTerminate.load();
 				});
 			}
 
 			if(!m_errors.empty())
 			{
+				std::vector<Error> errors;
+				errors.swap(m_errors);
+				lk.unlock(); //<-- Callback may throw.
+
 				if(ERROR_CALLBACK)
 				{
-					for(const auto& ERROR : m_errors)
+					for(const auto& ERROR : errors)
 					{
 						ERROR_CALLBACK(ERROR);
 					}
 				}
-				m_errors.clear();
 			}
 		}
 
@@ -173,6 +430,78 @@ namespace dpl
 			throw dpl::Logger::ref().push_error("Worker[%d] failed: %s", ERROR.workerID, ERROR.message().c_str());
 		}
 
+	protected: // functions
+		bool							is_worker_thread() const
+		{
+			return sm_worker && sm_worker->pool == this;
+		}
+
+		/*
+			Executes TASK in the calling thread, exceptions are reported as errors of the MAIN_THREAD_ID.
+		*/
+		void							execute_in_caller(					const Task&				TASK)
+		{
+			try
+			{
+				TASK();
+			}
+			catch(const std::runtime_error& EXCEPTION)
+			{
+				push_error(MAIN_THREAD_ID, EXCEPTION.what());
+			}
+			catch(...)
+			{
+				push_error(MAIN_THREAD_ID, "ThreadPool: Unknown exception");
+			}
+		}
+
+		/*
+			Calling thread executes queued tasks until DONE() returns true, then it returns without waiting for the rest of the tasks.
+			Unlike wait, it may be called by the worker of this pool(e.g. by the task that waits for tasks it added).
+		*/
+		template<typename DoneT>
+		void							help_until(							DoneT&&					DONE)
+		{
+			static thread_local std::minstd_rand random(static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+
+			Multition* const	CALLER_WORLD	= Multition::current(); //<-- Executed tasks may bind another world.
+			Worker* const		WORKER			= (sm_worker && sm_worker->pool == this)? sm_worker : nullptr;
+			uint32_t			round			= 0;
+			while(!DONE())
+			{
+				QueuedTask* queued = nullptr;
+				if(WORKER)
+				{
+					queued = find_task(*WORKER);
+				}
+				else if(m_numQueued.load(std::memory_order_acquire) > 0)
+				{
+					queued = take_injected(nullptr);
+					if(queued)	queued = take(queued);
+					else		queued = steal_task(nullptr, random());
+				}
+
+				if(queued)
+				{
+					execute(WORKER? WORKER->ID : MAIN_THREAD_ID, queued);
+					bind_world(CALLER_WORLD);
+					round = 0;
+				}
+				else if(round < NUM_SPIN_ROUNDS)
+				{
+					for(uint32_t index = 0; index < (1u << round); ++index)
+					{
+						Thread::pause();
+					}
+					++round;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
 	private: // functions
 		template <class T>
 		std::reference_wrapper<T>		wrap(								T&						val)
@@ -188,109 +517,336 @@ namespace dpl
 
 		void							start(								const uint32_t			NUM_THREADS)
 		{
-			for (uint32_t workerID = 0; workerID < NUM_THREADS; ++workerID) 
+			m_workers.reserve(NUM_THREADS);
+			for(uint32_t workerID = 0; workerID < NUM_THREADS; ++workerID) 
 			{
-				add_worker(workerID);
+				m_workers.emplace_back(new Worker(this, workerID));
+			}
+
+			// Workers are created before any thread starts, so that thieves can iterate m_workers without locking.
+			m_threads.reserve(NUM_THREADS);
+			for(auto& worker : m_workers) 
+			{
+				m_threads.emplace_back(&ThreadPool::run_worker, this, std::ref(*worker));
 			}
 		}
 
-		void							add_worker(							const uint32_t			WORKER_ID)
+		void							run_worker(							Worker&					worker)
 		{
-			std::thread([&, WORKER_ID]
+			sm_worker = &worker;
+			m_numWorkers.fetch_add(1, std::memory_order_release);
+
+			uint32_t round = 0;
+			while(!bTerminate.load(std::memory_order_acquire))
 			{
-				{std::lock_guard lk(m_mtx);
-					++m_numWorkers;
+				if(QueuedTask* queued = find_task(worker))
+				{
+					execute(worker.ID, queued);
+					round = 0;
 				}
-
-				while(true)
+				else if(round < NUM_SPIN_ROUNDS)
 				{
-					std::unique_lock lock(m_mtx);
-
-					m_order.wait(lock, [&] 
+					for(uint32_t index = 0; index < (1u << round); ++index)
 					{
-						return !m_tasks.empty() || bTerminate;
-					});
+						Thread::pause();
+					}
+					++round;
+				}
+				else if(round < NUM_SPIN_ROUNDS + NUM_YIELD_ROUNDS)
+				{
+					std::this_thread::yield();
+					++round;
+				}
+				else
+				{
+					park();
+					round = 0;
+				}
+			}
 
-					if (bTerminate) break;
+			sm_worker = nullptr;
+			m_numWorkers.fetch_sub(1, std::memory_order_release);
+		}
 
-					std::function<void()> task = std::move(m_tasks.front());
-					m_tasks.pop();
+		QueuedTask*						find_task(							Worker&					worker)
+		{
+			if(QueuedTask* queued = worker.deque.pop())
+				return take(queued);
 
-					lock.unlock();
-					try
-					{
-						task();
-					}
-					catch(const std::runtime_error& EXCEPTION)
-					{
-						push_error(WORKER_ID, EXCEPTION.what());
-					}
-					catch(...)
-					{
-						push_error(WORKER_ID, "ThreadPool: Unknown exception");
-					}
-					lock.lock();
+			if(m_numQueued.load(std::memory_order_acquire) == 0)
+				return nullptr;
 
-					--m_numTasks;
-					m_finished.notify_all();
-					if (bTerminate) break;
-				}
+			if(QueuedTask* queued = take_injected(&worker))
+				return take(queued);
+
+			return steal_task(&worker, worker.random());
+		}
+
+		/*
+			Tries each worker once, starting from a random victim.
+		*/
+		QueuedTask*						steal_task(							const Worker*			THIEF,
+																			const uint32_t			RANDOM)
+		{
+			const size_t NUM_WORKERS = m_workers.size();
+			if(NUM_WORKERS == 0)
+				return nullptr;
+
+			const size_t FIRST_VICTIM = RANDOM % NUM_WORKERS;
+			for(size_t offset = 0; offset < NUM_WORKERS; ++offset)
+			{
+				Worker& victim = *m_workers[(FIRST_VICTIM + offset) % NUM_WORKERS];
+				if(&victim == THIEF) 
+					continue;
+
+				if(QueuedTask* queued = victim.deque.steal())
+					return take(queued);
+			}
+
+			return nullptr;
+		}
+
+		/*
+			Calling thread executes queued tasks until there is nothing left to claim.
+			Tasks that are still in progress are awaited by the caller of this function.
+		*/
+		void							help_while_waiting()
+		{
+			while(m_numQueued.load(std::memory_order_acquire) > 0 && !bTerminate.load(std::memory_order_acquire))
+			{
+				QueuedTask* queued = take_injected(nullptr);
+				if(queued)	queued = take(queued);
+				else		queued = steal_task(nullptr, m_random());
 
-				notify_worker_release();
+				if(!queued) 
+					break;
 
-			}).detach();
+				execute(MAIN_THREAD_ID, queued);
+			}
 		}
 
-		void							notify_worker_release()
+		/*
+			Takes the first injected task and moves a share of the remaining ones to the worker deque(if given),
+			so that other workers steal them from there instead of contending on the injection queue.
+		*/
+		QueuedTask*						take_injected(						Worker*					worker)
 		{
-			std::unique_lock lock(m_mtx);
-			if(m_numWorkers > 0)
+			std::lock_guard lk(m_injectedMtx);
+			if(m_injected.empty())
+				return nullptr;
+
+			QueuedTask* queued = m_injected.front();
+			m_injected.pop_front();
+
+			if(!worker)
+				return queued;
+
+			const size_t NUM_MOVED = std::min(m_injected.size() / m_workers.size(), MAX_INJECTED_BATCH);
+			for(size_t index = 0; index < NUM_MOVED; ++index)
 			{
-				--m_numWorkers;
-				lock.unlock();
+				worker->deque.push(m_injected.front());
+				m_injected.pop_front();
+			}
+
+			return queued;
+		}
+
+		QueuedTask*						take(								QueuedTask*				queued)
+		{
+			m_numQueued.fetch_sub(1, std::memory_order_acq_rel);
+			return queued;
+		}
+
+		/*
+			Reuses a node from the given free list, allocates only if the list is empty.
+		*/
+		static QueuedTask*				make_queued(						std::vector<QueuedTask*>&	freeTasks,
+																			Task&&					task)
+		{
+			if(freeTasks.empty())
+				return new QueuedTask{std::move(task), Multition::current(), AccessCaller::current()};
+
+			QueuedTask* queued = freeTasks.back();
+			freeTasks.pop_back();
+			queued->task	= std::move(task);
+			queued->world	= Multition::current();
+			queued->caller	= AccessCaller::current();
+			return queued;
+		}
+
+		/*
+			Releases captures of the executed task and keeps its node for the next add_task.
+		*/
+		void							recycle(							QueuedTask*				queued)
+		{
+			queued->task.reset();
+
+			if(sm_worker && sm_worker->pool == this)
+			{
+				sm_worker->freeTasks.push_back(queued);
+				if(sm_worker->freeTasks.size() > MAX_FREE_TASKS)
+				{
+					std::lock_guard lk(m_injectedMtx);
+					move_free_tasks(sm_worker->freeTasks, m_freeTasks, MAX_FREE_TASKS / 2);
+				}
+			}
+			else
+			{
+				std::lock_guard lk(m_injectedMtx);
+				m_freeTasks.push_back(queued);
+			}
+		}
+
+		static void						move_free_tasks(					std::vector<QueuedTask*>&	source,
+																			std::vector<QueuedTask*>&	destination,
+																			const size_t			MAX_COUNT)
+		{
+			const size_t NUM_MOVED = std::min(source.size(), MAX_COUNT);
+			destination.insert(destination.end(), source.end() - NUM_MOVED, source.end());
+			source.resize(source.size() - NUM_MOVED);
+		}
+
+		void							execute(							const uint32_t			WORKER_ID,
+																			QueuedTask*				queued)
+		{
+			Multition* const CALLER_WORLD = Multition::current(); //<-- Restored for the waiting thread.
+			try
+			{
+				bind_world(queued->world);
+				const AccessCaller CALLER(queued->caller);
+				queued->task();
+			}
+			catch(const std::runtime_error& EXCEPTION)
+			{
+				push_error(WORKER_ID, EXCEPTION.what());
+			}
+			catch(...)
+			{
+				push_error(WORKER_ID, "ThreadPool: Unknown exception");
+			}
+
+			if(WORKER_ID == MAIN_THREAD_ID) 
+				bind_world(CALLER_WORLD);
+
+			recycle(queued);
+
+			if(m_numTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				std::lock_guard lk(m_mtx); //<-- Prevents lost wakeup between predicate check and wait.
 				m_finished.notify_all();
 			}
 		}
 
+		/*
+			Tasks added by the thread without the world must not see the world of the previous task.
+		*/
+		static void						bind_world(							Multition*				world)
+		{
+			if(world)							world->bind();
+			else if(Multition::current())		Multition::unbind();
+		}
+
+		void							park()
+		{
+			std::unique_lock lk(m_parkMtx);
+			m_numParked.fetch_add(1, std::memory_order_seq_cst);
+			m_order.wait(lk, [&]
+			{
+				return m_numQueued.load(std::memory_order_seq_cst) > 0 || bTerminate.load();
+			});
+			m_numParked.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void							wake_worker()
+		{
+			if(m_numParked.load(std::memory_order_seq_cst) > 0)
+			{
+				std::lock_guard lk(m_parkMtx);
+				m_order.notify_one();
+			}
+		}
+
+		void							wake_all_workers()
+		{
+			std::lock_guard lk(m_parkMtx);
+			m_order.notify_all();
+		}
+
 		void							push_error(							const uint32_t			WORKER_ID,
 																			const char*				MESSAGE)
 		{
 			{std::lock_guard<std::mutex> lk(m_mtx);
 				m_errors.emplace_back(WORKER_ID, MESSAGE);
 				bTerminate = true;
+				m_finished.notify_all();
 			}
 
-			m_order.notify_all();
+			wake_all_workers();
 		}
 
 		void							stop()
 		{
-			std::unique_lock lk(m_mtx);
 			bTerminate = true;
-			lk.unlock();
+			wake_all_workers();
 
-			m_order.notify_all();
+			for(auto& thread : m_threads)
+			{
+				if(thread.joinable()) thread.join();
+			}
+			m_threads.clear();
 
-			lk.lock(); // Wait until all workers are released.
-			if(m_numWorkers > 0)
+			// Release tasks that were never executed.
+			for(auto& worker : m_workers)
 			{
-				m_finished.wait(lk, [&] 
+				while(QueuedTask* queued = worker->deque.pop())
 				{
-					return m_numWorkers == 0;
-				});
+					delete queued;
+				}
+			}
+
+			for(QueuedTask* queued : m_injected)
+			{
+				delete queued;
+			}
+			m_injected.clear();
+
+			for(auto& worker : m_workers)
+			{
+				for(QueuedTask* queued : worker->freeTasks)
+				{
+					delete queued;
+				}
+				worker->freeTasks.clear();
+			}
+
+			for(QueuedTask* queued : m_freeTasks)
+			{
+				delete queued;
 			}
+			m_freeTasks.clear();
 		}
 	};
 
 	/*
 		ThreadPool optimization for large amount of tasks.
 
+		Scheduling::STATIC	- (default) tasks are assigned to jobs up front using their ratings, each job is executed by one worker.
+		Scheduling::DYNAMIC	- tasks go to a shared pool and workers claim them one by one through an atomic cursor,
+							  so the phase ends when the work runs out rather than when the slowest job finishes.
+		Scheduling::PERSISTENT	- like DYNAMIC, but workers stay resident between phases: they spin briefly on the epoch counter,
+							  then park on it. A phase is launched by bumping the epoch and completes on a countdown barrier.
+							  Residents occupy all workers until the scheduling is changed or the phase is destroyed,
+							  so post() and hosted phases throw in the meantime(their tasks would never be executed).
+		In all cases the thread that calls start() executes tasks too, instead of idling until the phase is done.
+		start_async() launches the phase without the calling thread and notifies the worker that finishes last.
+
+		Phase constructed from another phase(host) has no threads, its tasks are executed by the workers of the host.
+		Such phases can be started concurrently(also by the workers of the host), each of them waits only for its own tasks.
+
 		TODO:
 		- Do not derive from ThreadPool
 		- Disable adding task while threads are running.
 		- Notify all threads with their own tasks.
-		- Threads should increment work counter while they start and decrement it when they finish.
-		- Main thread should wait on the semaphore until counter reaches 0.
 	*/
 	class ParallelPhase : private ThreadPool
 	{
@@ -299,6 +855,13 @@ namespace dpl
 		using	Error			= ThreadPool::Error;
 		using	ErrorCallback	= ThreadPool::ErrorCallback;
 
+		enum class Scheduling
+		{
+			STATIC,
+			DYNAMIC,
+			PERSISTENT
+		};
+
 		struct	Job
 		{
 			std::vector<Task>	tasks;
@@ -306,7 +869,7 @@ namespace dpl
 
 			void add_task(const uint32_t RATING, Task task)
 			{
-				tasks.emplace_back(task);
+				tasks.emplace_back(std::move(task));
 				rating += RATING;
 			}
 		};
@@ -314,21 +877,66 @@ namespace dpl
 	public: // data
 		ReadOnly<uint32_t, ParallelPhase> numTasks;
 
+	private: // constants
+		static constexpr uint32_t	NUM_RESIDENT_SPINS	= 1024;	//<-- Pauses before a resident worker(or the waiting thread) yields.
+		static constexpr uint32_t	NUM_RESIDENT_YIELDS	= 16;	//<-- Yields before it parks on the atomic.
+
 	private: // data
-		dpl::DynamicArray<Job>		jobs;
-		dpl::DynamicArray<uint32_t>	workOrder;
+		dpl::DynamicArray<Job>				jobs;
+		dpl::DynamicArray<uint32_t>			workOrder;
+		Scheduling							m_scheduling;
+		Job									m_shared;			//<-- Task pool of the DYNAMIC and PERSISTENT scheduling.
+		alignas(64) std::atomic<uint32_t>	m_cursor;			//<-- Index of the next unclaimed task in the shared pool.
+		alignas(64) std::atomic<uint32_t>	m_epoch;			//<-- Bumped to launch a PERSISTENT phase.
+		alignas(64) std::atomic<uint32_t>	m_numBusy;			//<-- Countdown of residents(or asynchronous workers) that did not finish the current phase.
+		std::atomic<bool>					bStopResidents;
+		std::atomic<uint32_t>				m_numResidents;		//<-- Checked by the hosted phases, see@ add_host_task.
+		std::mutex							m_errorMtx;			//<-- Guards m_phaseErrors.
+		std::vector<Error>					m_phaseErrors;		//<-- Errors of the PERSISTENT, asynchronous and hosted phases.
+		Task								m_onDone;			//<-- Invoked when the asynchronous phase is done.
+		ParallelPhase*						m_host;				//<-- Phase that owns the workers(this, unless the phase is hosted).
+
+		static inline thread_local const ParallelPhase*	sm_resident = nullptr; //<-- Phase that the calling thread is a resident of.
 
 	public: // lifecycle
-		CLASS_CTOR		ParallelPhase(	const uint32_t			NUM_THREADS = std::thread::hardware_concurrency())
+		CLASS_CTOR		ParallelPhase(	const uint32_t			NUM_THREADS = std::thread::hardware_concurrency(),
+										const Scheduling		SCHEDULING	= Scheduling::STATIC)
 			: ThreadPool(NUM_THREADS)
 			, numTasks(0)
+			, m_scheduling(SCHEDULING)
+			, m_cursor(0)
+			, m_epoch(0)
+			, m_numBusy(0)
+			, bStopResidents(false)
+			, m_numResidents(0)
+			, m_host(this)
 		{
-			jobs.resize(NUM_THREADS);
-			workOrder.resize(jobs.size());
-			for(uint32_t index = 0; index < jobs.size(); ++index)
-			{
-				workOrder[index] = index;
-			}
+			ParallelPhase::init_jobs(NUM_THREADS);
+		}
+
+		/*
+			Creates phase without threads, executed by the workers of the HOST(see@ help_until).
+			PERSISTENT scheduling is not supported, residents would occupy workers of the host.
+		*/
+		CLASS_CTOR		ParallelPhase(	ParallelPhase&			host,
+										const Scheduling		SCHEDULING	= Scheduling::STATIC)
+			: ThreadPool(0)
+			, numTasks(0)
+			, m_scheduling(Scheduling::STATIC)
+			, m_cursor(0)
+			, m_epoch(0)
+			, m_numBusy(0)
+			, bStopResidents(false)
+			, m_numResidents(0)
+			, m_host(host.m_host)
+		{
+			ParallelPhase::init_jobs(m_host->numJobs());
+			ParallelPhase::set_scheduling(SCHEDULING);
+		}
+
+		CLASS_DTOR		~ParallelPhase()
+		{
+			stop_residents(); //<-- Parked residents would block ThreadPool::stop.
 		}
 
 	public: // functions
@@ -337,8 +945,36 @@ namespace dpl
 			return jobs.size();
 		}
 
+		Scheduling		get_scheduling() const
+		{
+			return m_scheduling;
+		}
+
+		/*
+			Must be called between phases.
+		*/
+		void			set_scheduling(	const Scheduling		SCHEDULING)
+		{
+			if(numTasks() > 0)
+				throw dpl::GeneralException(this, __LINE__, "Scheduling cannot be changed while the phase has pending tasks.");
+
+			if(SCHEDULING == Scheduling::PERSISTENT && is_hosted())
+				throw dpl::GeneralException(this, __LINE__, "PERSISTENT scheduling requires the phase to own its workers.");
+
+			if(SCHEDULING != Scheduling::PERSISTENT)
+				stop_residents();
+
+			m_scheduling = SCHEDULING;
+		}
+
 		void			reserve_tasks(	const uint32_t			NUM_TASKS)
 		{
+			if(m_scheduling != Scheduling::STATIC)
+			{
+				m_shared.tasks.reserve(NUM_TASKS);
+				return;
+			}
+
 			const auto CAPACITY = 2 * (1 + NUM_TASKS/jobs.size());
 			jobs.for_each([&](Job& job)
 			{
@@ -347,20 +983,227 @@ namespace dpl
 		}
 
 		/*
-			Add tasks with user defined rating of time complexity.
+			Add tasks with user defined rating of time complexity(used only by the STATIC scheduling).
 		*/
 		void			add_task(		const uint32_t			RATING, 
 										Task					task)
 		{
-			jobs[workOrder[0]].add_task(RATING, task);
-			update_work_order();
+			if(m_scheduling != Scheduling::STATIC)
+			{
+				m_shared.add_task(RATING, std::move(task));
+			}
+			else
+			{
+				jobs[workOrder[0]].add_task(RATING, std::move(task));
+				update_work_order();
+			}
 			++(*numTasks);
 		}
 
+		/*
+			Executes the phase and returns when all of its tasks are done.
+			Resident of the PERSISTENT phase cannot start it synchronously(e.g. from ON_DONE of start_async), it would wait for itself.
+			Worker of the phase(e.g. ON_DONE of other schedulings) waits only for the tasks of the phase.
+		*/
 		void			start(			const ErrorCallback&	ERROR_CALLBACK = &ThreadPool::log_and_throw_first_worker_error)
+		{
+			if(sm_resident == this)
+				throw dpl::GeneralException(this, __LINE__, "Resident cannot start its phase synchronously, use start_async instead.");
+
+			if(is_hosted() || m_host->is_worker_thread())
+			{
+				start_and_help(ERROR_CALLBACK);
+				return;
+			}
+
+			if(m_scheduling == Scheduling::PERSISTENT)
+			{
+				start_persistent(ERROR_CALLBACK);
+				return;
+			}
+
+			if(numTasks() > 0)
+			{
+				if(m_scheduling == Scheduling::DYNAMIC)
+				{
+					start_dynamic();
+				}
+				else
+				{
+					start_static();
+				}
+			}
+			
+			ThreadPool::wait(ERROR_CALLBACK); //<-- Calling thread helps with the remaining tasks.
+			clear_tasks();
+		}
+
+		/*
+			Launches the phase and returns immediately, ON_DONE is invoked by the worker that finishes last
+			(or by the calling thread if there are no tasks). Errors are kept until flush_errors.
+			Phase must not be modified or started again until ON_DONE is invoked.
+		*/
+		void			start_async(	Task					onDone)
+		{
+			if(numTasks() == 0)
+			{
+				onDone();
+				return;
+			}
+
+			m_onDone = std::move(onDone);
+			m_cursor.store(0, std::memory_order_relaxed);
+
+			if(m_scheduling == Scheduling::PERSISTENT)
+			{
+				if(m_numResidents == 0)
+					start_residents();
+
+				m_numBusy.store(m_numResidents, std::memory_order_relaxed);
+				m_epoch.fetch_add(1, std::memory_order_release);
+				m_epoch.notify_all();
+				return;
+			}
+
+			if(m_scheduling == Scheduling::DYNAMIC)
+			{
+				const uint32_t NUM_CLAIMERS = std::min(numJobs(), numTasks());
+				m_numBusy.store(NUM_CLAIMERS + 1, std::memory_order_relaxed); //<-- Calling thread holds the phase until all claimers are added.
+				for(uint32_t claimerID = 0; claimerID < NUM_CLAIMERS; ++claimerID)
+				{
+					add_host_task([&, claimerID]()
+					{
+						run_or_record_error(claimerID, [&](){ claim_tasks(); });
+						count_down_async();
+					});
+				}
+				count_down_async();
+				return;
+			}
+
+			uint32_t numLaunched = 0;
+			jobs.for_each([&](Job& job)
+			{
+				if(!job.tasks.empty()) ++numLaunched;
+			});
+
+			m_numBusy.store(numLaunched + 1, std::memory_order_relaxed);
+			for(uint32_t jobID = 0; jobID < jobs.size(); ++jobID)
+			{
+				if(jobs[jobID].tasks.empty()) 
+					continue;
+
+				add_host_task([&, jobID]()
+				{
+					run_or_record_error(jobID, [&]()
+					{
+						for(auto& task : jobs[jobID].tasks)
+						{
+							task();
+						}
+					});
+					count_down_async();
+				});
+			}
+			count_down_async();
+		}
+
+		/*
+			Adds TASK to the workers of the phase, it is not a part of any phase(see@ help_until).
+			Throws while the workers are occupied by the residents of the PERSISTENT phase.
+		*/
+		void			post(			Task					task)
+		{
+			add_host_task(std::move(task));
+		}
+
+		/*
+			Calling thread executes tasks of the workers until DONE() returns true.
+			May be called by the worker(e.g. from the posted task), unlike start() of the phase that owns the workers.
+		*/
+		template<typename DoneT>
+		void			help_until(		DoneT&&					DONE)
+		{
+			m_host->ThreadPool::help_until(std::forward<DoneT>(DONE));
+		}
+
+		/*
+			Passes errors of the last PERSISTENT, asynchronous or hosted phase to the ERROR_CALLBACK.
+		*/
+		void			flush_errors(	const ErrorCallback&	ERROR_CALLBACK = &ThreadPool::log_and_throw_first_worker_error)
+		{
+			std::vector<Error> errors;
+			{std::lock_guard lk(m_errorMtx);
+				errors.swap(m_phaseErrors);
+			}
+
+			if(ERROR_CALLBACK)
+			{
+				for(const auto& ERROR : errors)
+				{
+					ERROR_CALLBACK(ERROR);
+				}
+			}
+		}
+
+	private: // functions
+		bool			is_hosted() const
+		{
+			return m_host != this;
+		}
+
+		// Residents occupy all workers of the host, task added in the meantime would never be executed.
+		void			add_host_task(	Task					task)
+		{
+			if(m_host->m_numResidents.load(std::memory_order_acquire) > 0)
+				throw dpl::GeneralException(this, __LINE__, "Fail to add task. Workers are occupied by the residents of the PERSISTENT phase.");
+
+			m_host->ThreadPool::add_task(std::move(task));
+		}
+
+		void			init_jobs(		const uint32_t			NUM_JOBS)
+		{
+			jobs.resize(NUM_JOBS);
+			workOrder.resize(jobs.size());
+			for(uint32_t index = 0; index < jobs.size(); ++index)
+			{
+				workOrder[index] = index;
+			}
+		}
+
+		void			clear_tasks()
+		{
+			jobs.for_each([&](Job& job)
+			{
+				job.tasks.clear();
+				job.rating = 0;
+			});
+
+			m_shared.tasks.clear();
+			m_shared.rating = 0;
+			numTasks = 0;
+		}
+
+		/*
+			Called by each worker of the asynchronous phase, the last one clears the phase and invokes m_onDone.
+		*/
+		void			count_down_async()
+		{
+			if(m_numBusy.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+
+			Task onDone = std::move(m_onDone);
+			clear_tasks();
+			onDone(); //<-- Phase may be started again from here(only asynchronously if this is a resident, see@ start).
+		}
+
+		void			start_static()
 		{
 			jobs.for_each([&](Job& job)
 			{
+				if(job.tasks.empty()) 
+					return;
+
 				ThreadPool::add_task([&]()
 				{
 					for(auto index = 0u; index < job.tasks.size(); ++index)
@@ -369,19 +1212,219 @@ namespace dpl
 					}
 				});
 			});
-			
-			ThreadPool::wait(ERROR_CALLBACK);
+		}
 
-			jobs.for_each([&](Job& job)
+		void			start_dynamic()
+		{
+			m_cursor.store(0, std::memory_order_relaxed);
+			const uint32_t NUM_CLAIMERS = std::min(numJobs(), numTasks() - 1); //<-- Calling thread is a claimer too.
+			for(uint32_t index = 0; index < NUM_CLAIMERS; ++index)
 			{
-				job.tasks.clear();
-				job.rating = 0;
+				ThreadPool::add_task([&]()
+				{
+					claim_tasks();
+				});
+			}
+
+			ThreadPool::execute_in_caller([&]()
+			{
+				claim_tasks();
 			});
+		}
 
-			numTasks = 0;
+		void			start_persistent(const ErrorCallback&	ERROR_CALLBACK)
+		{
+			if(numTasks() > 0)
+			{
+				if(m_numResidents == 0)
+					start_residents();
+
+				m_cursor.store(0, std::memory_order_relaxed);
+				m_numBusy.store(m_numResidents, std::memory_order_relaxed);
+				m_epoch.fetch_add(1, std::memory_order_release); //<-- Publishes tasks, cursor and countdown.
+				m_epoch.notify_all();
+
+				run_or_record_error(MAIN_THREAD_ID, [&](){ claim_tasks(); });
+				wait_for_residents();
+			}
+
+			clear_tasks();
+			flush_errors(ERROR_CALLBACK);
+		}
+
+		/*
+			Tasks are executed by the workers of the host, calling thread claims tasks too and then helps the host until the countdown ends.
+			Used by hosted phases and by workers of the phase, that cannot wait for all tasks of their pool.
+		*/
+		void			start_and_help(	const ErrorCallback&	ERROR_CALLBACK)
+		{
+			if(numTasks() > 0)
+			{
+				if(m_scheduling != Scheduling::STATIC) //<-- Tasks of the PERSISTENT phase are claimed from the shared pool too(residents are not running).
+				{
+					m_cursor.store(0, std::memory_order_relaxed);
+					const uint32_t NUM_CLAIMERS = std::min(numJobs(), numTasks() - 1); //<-- Calling thread is a claimer too.
+					m_numBusy.store(NUM_CLAIMERS, std::memory_order_relaxed);
+					for(uint32_t claimerID = 0; claimerID < NUM_CLAIMERS; ++claimerID)
+					{
+						add_host_task([&, claimerID]()
+						{
+							run_or_record_error(claimerID, [&](){ claim_tasks(); });
+							m_numBusy.fetch_sub(1, std::memory_order_acq_rel);
+						});
+					}
+					run_or_record_error(MAIN_THREAD_ID, [&](){ claim_tasks(); });
+				}
+				else
+				{
+					uint32_t numLaunched = 0;
+					jobs.for_each([&](Job& job)
+					{
+						if(!job.tasks.empty()) ++numLaunched;
+					});
+
+					m_numBusy.store(numLaunched, std::memory_order_relaxed);
+					for(uint32_t jobID = 0; jobID < jobs.size(); ++jobID)
+					{
+						if(jobs[jobID].tasks.empty()) 
+							continue;
+
+						add_host_task([&, jobID]()
+						{
+							run_or_record_error(jobID, [&]()
+							{
+								for(auto& task : jobs[jobID].tasks)
+								{
+									task();
+								}
+							});
+							m_numBusy.fetch_sub(1, std::memory_order_acq_rel);
+						});
+					}
+				}
+
+				m_host->ThreadPool::help_until([&]()
+				{
+					return m_numBusy.load(std::memory_order_acquire) == 0;
+				});
+			}
+
+			clear_tasks();
+			flush_errors(ERROR_CALLBACK);
+		}
+
+		void			start_residents()
+		{
+			m_numResidents = numJobs();
+			const uint32_t EPOCH = m_epoch.load(std::memory_order_relaxed);
+			for(uint32_t residentID = 0; residentID < m_numResidents; ++residentID)
+			{
+				ThreadPool::add_task([&, residentID, EPOCH]()
+				{
+					run_resident(residentID, EPOCH);
+				});
+			}
+		}
+
+		void			stop_residents()
+		{
+			if(m_numResidents == 0)
+				return;
+
+			bStopResidents.store(true, std::memory_order_relaxed);
+			m_epoch.fetch_add(1, std::memory_order_release);
+			m_epoch.notify_all();
+			ThreadPool::wait(nullptr);
+
+			bStopResidents.store(false, std::memory_order_relaxed);
+			m_numResidents = 0;
+		}
+
+		void			run_resident(	const uint32_t			RESIDENT_ID,
+										uint32_t				epoch)
+		{
+			sm_resident = this;
+			while(true)
+			{
+				epoch = wait_for_change(m_epoch, epoch);
+				if(bStopResidents.load(std::memory_order_relaxed))
+				{
+					sm_resident = nullptr;
+					return;
+				}
+
+				run_or_record_error(RESIDENT_ID, [&](){ claim_tasks(); });
+
+				if(m_onDone) //<-- Published by the epoch.
+				{
+					count_down_async();
+				}
+				else if(m_numBusy.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					m_numBusy.notify_one();
+				}
+			}
+		}
+
+		void			wait_for_residents()
+		{
+			uint32_t numBusy = m_numBusy.load(std::memory_order_acquire);
+			while(numBusy > 0)
+			{
+				numBusy = wait_for_change(m_numBusy, numBusy);
+			}
+		}
+
+		/*
+			Spins, then yields, then parks until the ATOMIC differs from the OLD_VALUE.
+			Returns the new value.
+		*/
+		static uint32_t	wait_for_change(const std::atomic<uint32_t>& ATOMIC,
+										const uint32_t				OLD_VALUE)
+		{
+			for(uint32_t round = 0; round < NUM_RESIDENT_SPINS + NUM_RESIDENT_YIELDS; ++round)
+			{
+				const uint32_t VALUE = ATOMIC.load(std::memory_order_acquire);
+				if(VALUE != OLD_VALUE) 
+					return VALUE;
+
+				if(round < NUM_RESIDENT_SPINS)	Thread::pause();
+				else							std::this_thread::yield();
+			}
+
+			ATOMIC.wait(OLD_VALUE, std::memory_order_acquire);
+			return ATOMIC.load(std::memory_order_acquire);
+		}
+
+		template<typename InvokeT>
+		void			run_or_record_error(const uint32_t		ID,
+											InvokeT&&			invoke)
+		{
+			try
+			{
+				invoke();
+			}
+			catch(const std::runtime_error& EXCEPTION)
+			{
+				std::lock_guard lk(m_errorMtx);
+				m_phaseErrors.emplace_back(ID, EXCEPTION.what());
+			}
+			catch(...)
+			{
+				std::lock_guard lk(m_errorMtx);
+				m_phaseErrors.emplace_back(ID, "ParallelPhase: Unknown exception");
+			}
+		}
+
+		void			claim_tasks()
+		{
+			const uint32_t NUM_TASKS = static_cast<uint32_t>(m_shared.tasks.size());
+			for(uint32_t index = m_cursor.fetch_add(1, std::memory_order_relaxed); index < NUM_TASKS; index = m_cursor.fetch_add(1, std::memory_order_relaxed))
+			{
+				m_shared.tasks[index]();
+			}
 		}
 
-	private: // functions
 		void			update_work_order()
 		{
 			const uint64_t NUM_JOBS = workOrder.size();
@@ -405,4 +1448,6 @@ namespace dpl
 	};
 }
 
-#pragma warning(default : 26812)
\ No newline at end of file
+#ifdef _MSC_VER
+#pragma warning(default : 26812)
+#endif
\ No newline at end of file
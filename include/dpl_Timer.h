@@ -22,15 +22,20 @@ namespace dpl
 		using Minutes		= std::chrono::duration<double, std::ratio<60>>;
 		using Hours			= std::chrono::duration<double, std::ratio<3600>>;
 
-		template<typename T>
-		struct Suffix;
-
-		template<> struct Suffix<Nanoseconds>{	static const char* get(){return "ns";}};
-		template<> struct Suffix<Microseconds>{	static const char* get(){return "us";}};
-		template<> struct Suffix<Milliseconds>{	static const char* get(){return "ms";}};
-		template<> struct Suffix<Seconds>{		static const char* get(){return "s";}};
-		template<> struct Suffix<Minutes>{		static const char* get(){return "min";}};
-		template<> struct Suffix<Hours>{		static const char* get(){return "h";}};
+		template<typename T> //<-- Explicit specializations are not allowed in class scope (GCC, Clang).
+		struct Suffix
+		{
+			static const char* get()
+			{
+				if constexpr		(std::is_same_v<T, Nanoseconds>)	return "ns";
+				else if constexpr	(std::is_same_v<T, Microseconds>)	return "us";
+				else if constexpr	(std::is_same_v<T, Milliseconds>)	return "ms";
+				else if constexpr	(std::is_same_v<T, Seconds>)		return "s";
+				else if constexpr	(std::is_same_v<T, Minutes>)		return "min";
+				else if constexpr	(std::is_same_v<T, Hours>)			return "h";
+				else static_assert(!std::is_same_v<T, T>, "Unknown duration type.");
+			}
+		};
 
 		enum Flags
 		{
@@ -61,7 +66,11 @@ namespace dpl
 			std::time_t		tmp = std::chrono::system_clock::to_time_t(now());
 			const size_t	MAX_CHARACTERS = 50; 
 			char			str[MAX_CHARACTERS];
+#ifdef _MSC_VER
 			ctime_s(str, MAX_CHARACTERS, &tmp);
+#else
+			ctime_r(&tmp, str);
+#endif
 			return std::string(str);
 		}
 
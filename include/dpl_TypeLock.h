@@ -3,6 +3,8 @@
 
 #include <mutex>
 #include <atomic>
+#include <thread>
+#include "dpl_ClassInfo.h"
 
 
 namespace dpl
@@ -34,11 +34,11 @@ namespace dpl
 		template <typename T>
 		struct HasType<T, TypeList<>> : std::false_type {};
 
-		template <typename T, typename U, typename... Ts>
-		struct HasType<T, TypeList<U, Ts...>> : HasType<T, TypeList<Ts...>> {};
+		template <typename T, typename U, typename... Us>
+		struct HasType<T, TypeList<U, Us...>> : HasType<T, TypeList<Us...>> {};
 
-		template <typename T, typename... Ts>
-		struct HasType<T, TypeList<T, Ts...>> : std::true_type {};
+		template <typename T, typename... Us>
+		struct HasType<T, TypeList<T, Us...>> : std::true_type {};
 
 		template <class T, class TPack>
 		struct IndexOf;
@@ -109,11 +109,8 @@ namespace dpl
 			}
 		};
 
-		template <typename... Ts>
-		struct Reverse;
-
-		template <>
-		struct Reverse<>
+		template <typename... Us> //<-- Primary template handles empty list (explicit specialization is not allowed in class scope).
+		struct Reverse
 		{
 			using types = dpl::TypeList<>;
 		};
@@ -124,24 +121,36 @@ namespace dpl
 			using types = dpl::TypeList<T>;
 		};
 
-		template <typename T, typename... Ts>
-		struct Reverse<T, Ts...>
+		template <typename T, typename U, typename... Us>
+		struct Reverse<T, U, Us...>
 		{
 		private:
-			using tail	= typename Reverse<Ts...>::types;
+			using tail	= typename Reverse<U, Us...>::types;
 		
 		public:
-			using types	= tail::template push_back<T>;
+			using types	= typename tail::template push_back<T>;
+		};
+
+		// Reverses types without instantiation of the TypeList (it may be the incomplete type that is being defined).
+		template <typename TupleT, typename... Us>
+		struct ReverseTuple
+		{
+			using type = TupleT;
 		};
 
-		template<template<typename> class, class... Vs >
-		static auto get_Subtypes( TypeList<>, TypeList<Vs...> v ) { return v; }
+		template <typename... As, typename U, typename... Us>
+		struct ReverseTuple<std::tuple<As...>, U, Us...> : ReverseTuple<std::tuple<U, As...>, Us...> {};
+
+		// Accepted types are pushed to the front of the ResultT (in reversed order).
+		template<template<typename> class PREDICATE, typename ResultT, typename... Us>
+		struct Filter
+		{
+			using type = ResultT;
+		};
 
-		template<template<typename> class PREDICATE, class U, class... Us, class... Vs >
-		static auto get_Subtypes( TypeList<U, Us...>, TypeList<Vs...> ) 
-		{ 
-			return get_Subtypes<PREDICATE>(TypeList<Us...>{}, std::conditional_t<PREDICATE<U>::value, TypeList<U, Vs...>, TypeList<Vs...> >{}
-		);}
+		template<template<typename> class PREDICATE, typename... Vs, typename U, typename... Us>
+		struct Filter<PREDICATE, TypeList<Vs...>, U, Us...> 
+			: Filter<PREDICATE, std::conditional_t<PREDICATE<U>::value, TypeList<U, Vs...>, TypeList<Vs...>>, Us...> {};
 
 	public:
 		using	type = TypeList<Ts...>;
@@ -173,7 +182,7 @@ namespace dpl
 		using	At					= typename Extract<INDEX, Ts...>::type;
 
 		template <template <typename> class PREDICATE>
-		using	Subtypes			= decltype(TypeList::get_Subtypes<PREDICATE>( TypeList<Ts...>{}, TypeList<>{} ));
+		using	Subtypes			= typename Filter<PREDICATE, TypeList<>, Ts...>::type;
 
 		template<typename T>
 		using	push_front			= dpl::TypeList<T, Ts...>;
@@ -190,9 +199,9 @@ namespace dpl
 		using	DataPack_r			= std::tuple<Ts...>;
 		using	PtrPack_r			= std::tuple<Ts*...>;
 		using	ConstPtrPack_r		= std::tuple<const Ts*...>;
-		using	DataPack			= reverse<true>::DataPack_r;
-		using	PtrPack				= reverse<true>::PtrPack_r;
-		using	ConstPtrPack		= reverse<true>::ConstPtrPack_r;
+		using	DataPack			= typename ReverseTuple<std::tuple<>, Ts...>::type;
+		using	PtrPack				= typename ReverseTuple<std::tuple<>, Ts*...>::type;
+		using	ConstPtrPack		= typename ReverseTuple<std::tuple<>, const Ts*...>::type;
 
 		static constexpr size_t SIZE		= (0 + ... + Increment<Ts>::VALUE);
 		static constexpr bool	ALL_UNIQUE	= std::is_same_v<Unique, TypeList<Ts...>>;
@@ -2,6 +2,7 @@
 
 
 #include <functional>
+#include <limits>
 #include "dpl_Mask.h"
 #include "dpl_Range.h"
 #include "dpl_Binary.h"
@@ -27,8 +27,7 @@ namespace dpl
 	protected: // subtypes
 		using MyType		= Variation<VariationT, VariantT>;
 		using MyVariant		= Variant<VariationT, VariantT>;
-		using MyVariants	= std::unordered_map<std::type_index, std::unique_ptr<MyVariant>>;
-		using MyIterator	= typename MyVariants::iterator;
+		using MyVariants	= std::vector<std::unique_ptr<MyVariant>>; //<-- Indexed with typeID.
 
 	public: // subtypes
 		class	Binding
@@ -53,16 +52,23 @@ namespace dpl
 		friend	MyVariant;
 
 	private: // data
-		MyVariants m_variants;
+		MyVariants	m_variants;
+		uint32_t	m_numVariants;
 
 	protected: // lifecycle
-		CLASS_CTOR				Variation() = default;
+		CLASS_CTOR				Variation()
+			: m_numVariants(0)
+		{
+
+		}
 
 		CLASS_CTOR				Variation(					const Variation&						OTHER) = delete;
 
 		CLASS_CTOR				Variation(					Variation&&								other) noexcept
 			: m_variants(std::move(other.m_variants))
+			, m_numVariants(other.m_numVariants)
 		{
+			other.m_numVariants = 0;
 			bind_variants();
 		}
 
@@ -74,7 +80,9 @@ namespace dpl
 		{
 			if(this != &other)
 			{
-				m_variants = std::move(other.m_variants);
+				m_variants			= std::move(other.m_variants);
+				m_numVariants		= other.m_numVariants;
+				other.m_numVariants	= 0;
 				bind_variants();
 			}
 
@@ -84,6 +92,7 @@ namespace dpl
 		Variation&				operator=(					Swap<Variation>							other)
 		{
 			std::swap(m_variants, other->m_variants);
+			std::swap(m_numVariants, other->m_numVariants);
 			bind_variants();
 			other->bind_variants();
 			return *this;
@@ -103,19 +112,17 @@ namespace dpl
 
 		uint32_t				get_numVariants() const
 		{
-			return static_cast<uint32_t>(m_variants.size());
+			return m_numVariants;
 		}
 
 		VariantT*				find_base_variant(			const uint32_t							TYPE_ID)
 		{
-			auto it = m_variants.find(VariantHandler::get_typeInfo(TYPE_ID));
-			return (it != m_variants.end()) ? static_cast<VariantT*>(it->second.get()) : nullptr;
+			return (TYPE_ID < m_variants.size()) ? static_cast<VariantT*>(m_variants[TYPE_ID].get()) : nullptr;
 		}
 
 		const VariantT*			find_base_variant(			const uint32_t							TYPE_ID) const
 		{
-			auto it = m_variants.find(VariantHandler::get_typeInfo(TYPE_ID));
-			return (it != m_variants.end()) ? static_cast<const VariantT*>(it->second.get()) : nullptr;
+			return (TYPE_ID < m_variants.size()) ? static_cast<const VariantT*>(m_variants[TYPE_ID].get()) : nullptr;
 		}
 
 		VariantT*				find_base_variant(			const std::string&						VARIANT_NAME)
@@ -156,14 +163,13 @@ namespace dpl
 		template<typename T>
 		bool					has_variant() const
 		{
-			return m_variants.find(typeid(T)) != m_variants.end();
+			return Variation::has_variant(get_typeID<T>());
 		}
 
 		template<typename T>
 		const T*				find_variant() const
 		{
-			auto it = m_variants.find(typeid(T));
-			return (it != m_variants.end()) ? static_cast<const T*>(it->second.get()) : nullptr;
+			return static_cast<const T*>(Variation::find_base_variant(get_typeID<T>()));
 		}
 
 		template<typename T>
@@ -176,8 +182,7 @@ namespace dpl
 		template<typename T>
 		T*						find_variant()
 		{
-			auto it = m_variants.find(typeid(T));
-			return (it != m_variants.end()) ? static_cast<T*>(it->second.get()) : nullptr;
+			return static_cast<T*>(Variation::find_base_variant(get_typeID<T>()));
 		}
 
 		template<typename T>
@@ -188,16 +193,13 @@ namespace dpl
 
 		Result<VariantT*>		create_default_variant(		const uint32_t							TYPE_ID)
 		{
-			auto result = m_variants.emplace(VariantHandler::get_typeInfo(TYPE_ID), nullptr);
-			if(result.second)
-			{
-				std::unique_ptr<MyVariant>&	newVariant = result.first->second;
-											newVariant = VariantHandler::generate_object(TYPE_ID, Binding(*this));
+			if(VariantT* variant = Variation::find_base_variant(TYPE_ID))
+				return Result<VariantT*>(false, variant);
 
-				return Result<VariantT*>(true, static_cast<VariantT*>(newVariant.get()));
-			}
-
-			return Result<VariantT*>(false, static_cast<VariantT*>(result.first->second.get()));
+			std::unique_ptr<MyVariant>& newVariant = Variation::get_slot(TYPE_ID);
+										newVariant = VariantHandler::generate_object(TYPE_ID, Binding(*this));
+			++m_numVariants;
+			return Result<VariantT*>(true, static_cast<VariantT*>(newVariant.get()));
 		}
 
 		Result<VariantT*>		create_default_variant(		const std::string&						VARIANT_NAME)
@@ -209,75 +211,64 @@ namespace dpl
 		Result<T*>				create_variant(				CTOR&&...								args)
 		{
 			VariantHandler::template register_generator<T>();
-			auto result = m_variants.emplace(typeid(T), nullptr);
-			if(result.second)
-			{
-				std::unique_ptr<MyVariant>&	newVariant = result.first->second;
-											newVariant.reset(new T(Binding(*this), std::forward<CTOR>(args)...));
+			if(T* variant = Variation::find_variant<T>())
+				return Result<T*>(false, variant);
 
-				return Result<T*>(true, static_cast<T*>(newVariant.get()));
-			}
-
-			return Result<T*>(false, static_cast<T*>(result.first->second.get()));
+			std::unique_ptr<MyVariant>& newVariant = Variation::get_slot(get_typeID<T>());
+										newVariant.reset(new T(Binding(*this), std::forward<CTOR>(args)...));
+			++m_numVariants;
+			return Result<T*>(true, static_cast<T*>(newVariant.get()));
 		}
 
 		template<typename T>
 		bool					destroy_variant()
 		{
-			return destroy_variant_internal(typeid(T));
+			return Variation::destroy_variant(get_typeID<T>());
 		}
 
 		bool					destroy_variant(			const uint32_t							TYPE_ID)
 		{
-			return destroy_variant_internal(VariantHandler::get_typeInfo(TYPE_ID));
+			if(!Variation::has_variant(TYPE_ID)) return false;
+			destroy_variant_internal(TYPE_ID);
+			return true;
 		}
 
 		// Returns false if T was not present.
 		template<typename T>
 		bool					destroy_all_variants_except()
 		{
-			bool bResult = false;
-			auto it = m_variants.begin();
-			while(it != m_variants.end())
+			const uint32_t TYPE_ID = get_typeID<T>();
+			for(uint32_t typeID = 0; typeID < m_variants.size(); ++typeID)
 			{
-				if(it->first != typeid(T))
-				{
-					it = destroy_it_internal(it);
-				}
-				else
-				{
-					it = std::next(it);
-					bResult = true;
-				}
+				if(typeID != TYPE_ID && m_variants[typeID]) destroy_variant_internal(typeID);
 			}
-
-			return bResult;
+			return Variation::has_variant(TYPE_ID);
 		}
 
+		// Variants are destroyed in reverse order of their registration.
 		bool					destroy_all_variants()
 		{
-			if(m_variants.empty()) return false;
-			while(!m_variants.empty())
+			if(m_numVariants == 0) return false;
+			for(uint32_t typeID = (uint32_t)m_variants.size(); typeID > 0; --typeID)
 			{
-				auto it = m_variants.begin();
-				destroy_it_internal(it);
+				if(m_variants[typeID-1]) destroy_variant_internal(typeID-1);
 			}
 			return true;
 		}
 
 		void					iterate(					std::function<void(VariantT&)>			function)
 		{
-			for(auto& it : m_variants)
+			for(auto& variant : m_variants)
 			{
-				function(*it.second->cast());
+				if(variant) function(*variant->cast());
 			}
 		}
 
 		void					iterate(					std::function<void(const VariantT&)>	function) const
 		{
-			for(auto& it : m_variants)
+			for(auto& variant : m_variants)
 			{
-				function(*it.second->cast());
+				if(variant) function(*variant->cast());
 			}
 		}
 
@@ -292,21 +283,17 @@ namespace dpl
 		}
 
 	private: // functions
-		bool					destroy_variant_internal(	const std::type_index&					TYPE_INDEX)
+		std::unique_ptr<MyVariant>&	get_slot(				const uint32_t							TYPE_ID)
 		{
-			auto it = m_variants.find(TYPE_INDEX);
-			if(it != m_variants.end())
-			{
-				destroy_it_internal(it);		
-				return true;
-			}
-
-			return false;
+			if(TYPE_ID >= m_variants.size()) m_variants.resize(TYPE_ID + 1);
+			return m_variants[TYPE_ID];
 		}
 
-		MyIterator				destroy_it_internal(		MyIterator&								iterator)
+		void					destroy_variant_internal(	const uint32_t							TYPE_ID)
 		{
-			return m_variants.erase(iterator);
+			std::unique_ptr<MyVariant> variant = std::move(m_variants[TYPE_ID]); //<-- Slot is empty when destructor is called.
+			--m_numVariants;
+			variant.reset();
 		}
 
 	private: // functions
@@ -322,9 +309,9 @@ namespace dpl
 
 		void					bind_variants()
 		{
-			for(auto& it : m_variants)
+			for(auto& variant : m_variants)
 			{
-				it.second->variation = this;
+				if(variant) variant->variation = this;
 			}
 		}
 	};
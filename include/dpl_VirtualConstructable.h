@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <limits>
 #include <regex>
 #include "dpl_GeneralException.h"
 #include "dpl_NamedType.h"
@@ -28,9 +29,9 @@ namespace dpl
 
 			template<typename DerivedT>
 			CLASS_CTOR Generator(	const DerivedT*			DUMMY_POINTER,
-									const CTOR_Invoker&		CTOR)
+									const CTOR_Invoker&		INVOKER)
 				: info(typeid(DerivedT))
-				, ctor(CTOR)
+				, ctor(INVOKER)
 			{
 				static const std::regex STRUCT_REGEX("\\s*\\bstruct \\b");
 				static const std::regex CLASS_REGEX("\\s*\\bclass \\b");
@@ -48,13 +49,16 @@ namespace dpl
 		using	ClassGenerators	= std::vector<Generator>;
 
 	public: // constants
-		static const uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
 
 	private: // data
 		static ClassTypeMap		sm_typeMap;
 		static ClassNameMap		sm_nameMap;
 		static ClassGenerators	sm_generators;
 
+		template<typename DerivedT>
+		static inline uint32_t	sm_typeID = INVALID_INDEX; //<-- Assigned on registration.
+
 	public: // lifecycle
 		CLASS_CTOR						VirtualConstructable() = default;
 
@@ -97,7 +101,7 @@ namespace dpl
 		template<typename DerivedT>
 		static uint32_t					get_typeID()
 		{
-			return get_typeID(typeid(DerivedT));
+			return sm_typeID<DerivedT>;
 		}
 
 		static const std::type_index	get_typeInfo(			const uint32_t							TYPE_ID)
@@ -160,6 +164,7 @@ namespace dpl
 		
 				sm_typeMap.emplace(newGenerator.info, UNIQUE_ID);
 				sm_generators.emplace_back(newGenerator);
+				sm_typeID<DerivedT> = UNIQUE_ID;
 				return true;
 			}();
 		}
@@ -6,6 +6,10 @@
 #include <stdexcept>
 #include <limits>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 
 namespace dpl
 {
@@ -37,6 +41,16 @@ namespace dpl
 		return dpl::get_element_index(CONTAINER, &ELEMENT);
 	}
 
+	// Hints the processor to load the cache line with the given address (no effect on program behaviour).
+	inline void			prefetch(			const void*									ADDRESS)
+	{
+#if defined(_MSC_VER)
+		_mm_prefetch(static_cast<const char*>(ADDRESS), _MM_HINT_T0);
+#else
+		__builtin_prefetch(ADDRESS);
+#endif
+	}
+
 	/* 
 		Efficiently remove an element from a vector without
 		preserving order. If the element is not the last element
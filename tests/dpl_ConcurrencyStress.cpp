@@ -0,0 +1,378 @@
+/*
+	Concurrency stress test of the task system.
+
+	Usage: dpl_ConcurrencyStress [--rounds 20] [--threads N]
+
+	Covers WorkStealingDeque, ThreadPool(tasks added by workers and by other threads, futures),
+	StealableRange through parallel_for/parallel_reduce/parallel_exclusive_scan in every scheduling,
+	hosted phases started concurrently by workers of their host, and coroutine Task with co_await on a phase.
+	Uses more threads than cores by default, so that preemption interleaves the workers on small machines too.
+	Exits with 1 after the first round with failed checks, a deadlock is reported by the ctest timeout.
+*/
+#include "dpl_Parallel.h"
+#include "dpl_Task.h"
+#include "dpl_Logger.h"
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <string>
+
+
+namespace
+{
+	using	Scheduling	= dpl::ParallelPhase::Scheduling;
+
+	struct	Settings
+	{
+		uint32_t	rounds		= 20;
+		uint32_t	numThreads	= std::max(4u, 2 * std::thread::hardware_concurrency());
+	};
+
+	constexpr Scheduling ALL_SCHEDULINGS[] = {Scheduling::STATIC, Scheduling::DYNAMIC, Scheduling::PERSISTENT};
+
+	uint32_t g_numFailed = 0;
+
+	void			check(			const bool			bPASSED,
+									const char*			WHAT,
+									const uint32_t		ROUND)
+	{
+		if(bPASSED) return;
+		std::fprintf(stderr, "FAILED[round %u]: %s\n", ROUND, WHAT);
+		++g_numFailed;
+	}
+
+	// Phase errors are expected by some checks, they are counted instead of thrown.
+	dpl::ParallelPhase::ErrorCallback count_errors(std::atomic<uint32_t>& numErrors)
+	{
+		return [&numErrors](const dpl::ThreadPool::Error&){ ++numErrors; };
+	}
+
+
+	// Owner pushes and pops while thieves steal, each item must be taken exactly once.
+	void			stress_deque(	const Settings&		SETTINGS,
+									const uint32_t		ROUND)
+	{
+		constexpr uint32_t NUM_ITEMS = 100000;
+
+		std::vector<std::atomic<uint32_t>>	numTaken(NUM_ITEMS);
+		dpl::WorkStealingDeque<std::atomic<uint32_t>*> deque(16); //<-- Small, so that it grows while being stolen from.
+		std::atomic<bool>					bOwnerDone(false);
+
+		auto take = [&](std::atomic<uint32_t>* item)
+		{
+			if(item) item->fetch_add(1, std::memory_order_relaxed);
+			return item != nullptr;
+		};
+
+		std::vector<std::thread> thieves;
+		for(uint32_t thiefID = 1; thiefID < SETTINGS.numThreads; ++thiefID)
+		{
+			thieves.emplace_back([&]()
+			{
+				while(!bOwnerDone.load(std::memory_order_acquire) || !deque.empty())
+				{
+					if(!take(deque.steal())) std::this_thread::yield();
+				}
+			});
+		}
+
+		uint32_t next = 0;
+		while(next < NUM_ITEMS)
+		{
+			const uint32_t BURST_END = std::min(NUM_ITEMS, next + 1 + (next * 7919u) % 300);
+			for(; next < BURST_END; ++next)
+			{
+				deque.push(&numTaken[next]);
+			}
+
+			for(uint32_t index = 0; index < (next % 50); ++index)
+			{
+				take(deque.pop());
+			}
+		}
+		while(take(deque.pop())) {}
+		bOwnerDone.store(true, std::memory_order_release);
+
+		for(auto& thief : thieves) thief.join();
+
+		const bool bALL_ONCE = std::all_of(numTaken.begin(), numTaken.end(), [](const std::atomic<uint32_t>& COUNT){ return COUNT.load() == 1; });
+		check(bALL_ONCE, "WorkStealingDeque: each item is taken exactly once", ROUND);
+	}
+
+	// Tasks are added by other threads and by workers(nested), nodes are recycled between waits and pools.
+	void			stress_pool(	const Settings&		SETTINGS,
+									const uint32_t		ROUND)
+	{
+		constexpr uint32_t NUM_PRODUCERS		= 4;
+		constexpr uint32_t NUM_TASKS_PER_PRODUCER	= 2000;
+
+		dpl::ThreadPool		pool(SETTINGS.numThreads);
+		std::atomic<uint64_t>	numExecuted(0);
+
+		for(uint32_t wave = 0; wave < 3; ++wave)
+		{
+			numExecuted = 0;
+			std::vector<std::thread> producers;
+			for(uint32_t producerID = 0; producerID < NUM_PRODUCERS; ++producerID)
+			{
+				producers.emplace_back([&]()
+				{
+					for(uint32_t index = 0; index < NUM_TASKS_PER_PRODUCER; ++index)
+					{
+						pool.add_task([&pool, &numExecuted, index]()
+						{
+							++numExecuted;
+							if(index % 4 == 0) pool.add_task([&numExecuted](){ ++numExecuted; });
+						});
+					}
+				});
+			}
+
+			for(auto& producer : producers) producer.join();
+			pool.wait();
+			check(numExecuted == NUM_PRODUCERS * NUM_TASKS_PER_PRODUCER * 5 / 4, "ThreadPool: every added task is executed before wait returns", ROUND);
+			check(pool.get_numTasks() == 0, "ThreadPool: no tasks left after wait", ROUND);
+		}
+
+		std::vector<std::future<uint64_t>> futures;
+		for(uint64_t index = 0; index < 1000; ++index)
+		{
+			futures.push_back(pool.create_task([](const uint64_t VALUE){ return VALUE * VALUE; }, uint64_t(index))); //<-- Lvalue arguments are passed by reference.
+		}
+
+		std::future<void> failed = pool.create_task([](){ throw std::runtime_error("expected"); });
+
+		uint64_t sum = 0;
+		for(auto& future : futures) sum += future.get();
+		check(sum == 999ull * 1000 * 1999 / 6, "ThreadPool: create_task futures return their results", ROUND);
+
+		bool bThrown = false;
+		try { failed.get(); } catch(const std::runtime_error&) { bThrown = true; }
+		check(bThrown, "ThreadPool: create_task future rethrows the exception of the task", ROUND);
+		pool.wait();
+	}
+
+	// Parallel algorithms on the phase, checked against the serial results.
+	void			run_algorithms(	dpl::ParallelPhase&	phase,
+									const uint32_t		ROUND)
+	{
+		const uint32_t NUM_VALUES = 50000 + ROUND * 1000;
+
+		std::vector<std::atomic<uint8_t>> numVisits(NUM_VALUES);
+		for(const uint32_t GRAIN : {0u, 1u, 7u, 1000u})
+		{
+			for(auto& count : numVisits) count.store(0, std::memory_order_relaxed);
+			dpl::parallel_for(phase, dpl::IndexRange<>(0, NUM_VALUES), [&](const dpl::IndexRange<>& CHUNK)
+			{
+				CHUNK.for_each([&](const uint32_t INDEX){ numVisits[INDEX].fetch_add(1, std::memory_order_relaxed); });
+			}, GRAIN);
+
+			const bool bALL_ONCE = std::all_of(numVisits.begin(), numVisits.end(), [](const std::atomic<uint8_t>& COUNT){ return COUNT.load() == 1; });
+			check(bALL_ONCE, "parallel_for: each index is visited exactly once", ROUND);
+		}
+
+		const uint64_t SUM_OF_SQUARES = dpl::parallel_reduce(phase, dpl::IndexRange<>(0, NUM_VALUES), uint64_t(0),
+																[](const uint32_t INDEX){ return uint64_t(INDEX) * INDEX; },
+																[](const uint64_t FIRST, const uint64_t SECOND){ return FIRST + SECOND; });
+		const uint64_t N = NUM_VALUES - 1;
+		check(SUM_OF_SQUARES == N * (N + 1) * (2 * N + 1) / 6, "parallel_reduce: sum of squares", ROUND);
+
+		std::vector<uint64_t> values(NUM_VALUES);
+		std::iota(values.begin(), values.end(), uint64_t(1));
+		std::vector<uint64_t> expected(NUM_VALUES);
+		std::exclusive_scan(values.begin(), values.end(), expected.begin(), uint64_t(5));
+
+		const uint64_t TOTAL = dpl::parallel_exclusive_scan(phase, std::span<uint64_t>(values), [](const uint64_t FIRST, const uint64_t SECOND){ return FIRST + SECOND; }, uint64_t(5));
+		check(values == expected, "parallel_exclusive_scan: prefix sums", ROUND);
+		check(TOTAL == 5 + uint64_t(NUM_VALUES) * (NUM_VALUES + 1) / 2, "parallel_exclusive_scan: total", ROUND);
+		check(phase.numTasks() == 0, "ParallelPhase: no tasks left after the algorithms", ROUND);
+	}
+
+	void			stress_phases(	const Settings&		SETTINGS,
+									const uint32_t		ROUND)
+	{
+		for(const Scheduling SCHEDULING : ALL_SCHEDULINGS)
+		{
+			dpl::ParallelPhase phase(SETTINGS.numThreads, SCHEDULING);
+			run_algorithms(phase, ROUND);
+
+			if(SCHEDULING == Scheduling::PERSISTENT)
+			{
+				bool bPostThrown = false;
+				try { phase.post([](){}); } catch(const dpl::GeneralException&) { bPostThrown = true; }
+				check(bPostThrown, "ParallelPhase: post throws while the residents occupy the workers", ROUND);
+
+				dpl::ParallelPhase hosted(phase);
+				hosted.add_task(1, [](){});
+				bool bHostedThrown = false;
+				try { hosted.start(); } catch(const dpl::GeneralException&) { bHostedThrown = true; }
+				check(bHostedThrown, "ParallelPhase: hosted phase throws while the residents occupy the workers", ROUND);
+			}
+
+			// Error terminates the workers of the pool(residents keep running), so the phase is not used afterwards.
+			std::atomic<uint32_t> numErrors(0);
+			for(uint32_t index = 0; index < 64; ++index)
+			{
+				phase.add_task(1, [index](){ if(index % 16 == 0) throw std::runtime_error("expected"); });
+			}
+			phase.start(count_errors(numErrors));
+			check(numErrors > 0, "ParallelPhase: error of the task is reported by start", ROUND);
+		}
+	}
+
+	// Hosted phases are started concurrently by the workers of their host, each of them waits only for its own tasks.
+	void			stress_hosted_phases(	const Settings&		SETTINGS,
+											const uint32_t		ROUND)
+	{
+		constexpr uint32_t NUM_LANES = 4;
+
+		dpl::ParallelPhase host(SETTINGS.numThreads);
+		std::vector<std::unique_ptr<dpl::ParallelPhase>> lanes;
+		for(uint32_t laneID = 0; laneID < NUM_LANES; ++laneID)
+		{
+			lanes.emplace_back(std::make_unique<dpl::ParallelPhase>(host, (laneID % 2)? Scheduling::STATIC : Scheduling::DYNAMIC));
+		}
+
+		std::atomic<uint32_t> numPending(NUM_LANES);
+		for(auto& lane : lanes)
+		{
+			host.post([&, phase = lane.get()]()
+			{
+				run_algorithms(*phase, ROUND);
+				numPending.fetch_sub(1, std::memory_order_acq_rel);
+			});
+		}
+
+		host.help_until([&](){ return numPending.load(std::memory_order_acquire) == 0; });
+	}
+
+
+	std::atomic<uint64_t> g_phaseSum(0);
+
+	dpl::Task<uint64_t>	square(		const uint64_t		VALUE)
+	{
+		co_return VALUE * VALUE;
+	}
+
+	dpl::Task<uint64_t>	run_rounds(	dpl::ParallelPhase&	phase,
+									const uint32_t		NUM_ROUNDS)
+	{
+		uint64_t total = 0;
+		for(uint32_t round = 0; round < NUM_ROUNDS; ++round)
+		{
+			for(uint32_t index = 0; index < 32; ++index)
+			{
+				phase.add_task(1, [index](){ g_phaseSum.fetch_add(index, std::memory_order_relaxed); });
+			}
+			co_await phase;
+			total += co_await square(round);
+		}
+		co_return total;
+	}
+
+	dpl::Task<bool>		await_failing_phase(dpl::ParallelPhase&	phase)
+	{
+		phase.add_task(1, [](){ throw std::runtime_error("expected"); });
+		phase.add_task(1, [](){});
+		try
+		{
+			co_await phase;
+		}
+		catch(...) //<-- Default error callback throws the id of the logged message.
+		{
+			co_return true;
+		}
+		co_return false;
+	}
+
+	template<typename T>
+	T					wait_for(	dpl::Task<T>&		task)
+	{
+		while(!task.is_done()) std::this_thread::yield();
+		return task.get();
+	}
+
+	// Coroutines suspended on phases of every scheduling, resumed by the workers that finish them.
+	void			stress_coroutines(	const Settings&		SETTINGS,
+										const uint32_t		ROUND)
+	{
+		constexpr uint32_t NUM_COROUTINES	= 4;
+		constexpr uint32_t NUM_ROUNDS		= 50;
+
+		dpl::ThreadPool pool(SETTINGS.numThreads);
+		for(const Scheduling SCHEDULING : ALL_SCHEDULINGS)
+		{
+			std::vector<std::unique_ptr<dpl::ParallelPhase>>	phases;
+			std::vector<dpl::Task<uint64_t>>					tasks;
+			g_phaseSum = 0;
+
+			for(uint32_t coroutineID = 0; coroutineID < NUM_COROUTINES; ++coroutineID)
+			{
+				phases.emplace_back(std::make_unique<dpl::ParallelPhase>(2, SCHEDULING));
+				tasks.push_back(run_rounds(*phases.back(), NUM_ROUNDS));
+				tasks.back().start(pool);
+			}
+
+			const uint64_t EXPECTED = (NUM_ROUNDS - 1) * NUM_ROUNDS * (2 * NUM_ROUNDS - 1) / 6;
+			for(auto& task : tasks)
+			{
+				check(wait_for(task) == EXPECTED, "Task: co_await of phases and nested tasks returns the result", ROUND);
+			}
+			check(g_phaseSum == NUM_COROUTINES * NUM_ROUNDS * (31 * 32 / 2), "Task: tasks of every awaited phase are executed", ROUND);
+
+			dpl::Task<bool> failing = await_failing_phase(*phases.front());
+			failing.start(pool);
+			check(wait_for(failing), "Task: error of the awaited phase is thrown in the coroutine", ROUND);
+		}
+		pool.wait();
+	}
+
+	bool			parse_arguments(const int		ARGC,
+									char**			argv,
+									Settings&		settings)
+	{
+		for(int index = 1; index < ARGC; ++index)
+		{
+			const bool HAS_VALUE = index + 1 < ARGC;
+			if(std::strcmp(argv[index], "--rounds") == 0 && HAS_VALUE)
+			{
+				settings.rounds = std::max(1u, (uint32_t)std::stoul(argv[++index]));
+			}
+			else if(std::strcmp(argv[index], "--threads") == 0 && HAS_VALUE)
+			{
+				settings.numThreads = std::max(1u, (uint32_t)std::stoul(argv[++index]));
+			}
+			else
+			{
+				std::fprintf(stderr, "Usage: %s [--rounds 20] [--threads N]\n", argv[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+	if(!parse_arguments(argc, argv, settings)) return 1;
+
+	dpl::Multition	world;
+	dpl::Logger		logger(world); //<-- Default error callbacks log the errors.
+
+	for(uint32_t round = 0; round < settings.rounds; ++round)
+	{
+		stress_deque(settings, round);
+		stress_pool(settings, round);
+		stress_phases(settings, round);
+		stress_hosted_phases(settings, round);
+		stress_coroutines(settings, round);
+
+		if(g_numFailed > 0)
+			return 1;
+	}
+
+	std::fprintf(stderr, "%u rounds passed (%u threads)\n", settings.rounds, settings.numThreads);
+	return 0;
+}
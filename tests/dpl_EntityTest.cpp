@@ -0,0 +1,636 @@
+/*
+	Behaviour test of the entity system.
+
+	Usage: dpl_EntityTest
+
+	Each test runs in a fresh world and checks observable results(counts, values, order), not only that the code compiles.
+	Exits with 1 if any check failed.
+*/
+#include "dpl_EntityManager.h"
+#include <cstdio>
+#include <string>
+#include <thread>
+
+
+// test entities
+class	Ship;
+class	Node;
+class	Carrier;
+class	Drone;
+class	Pilot;
+
+struct	Hull
+{
+	float	integrity = 1.f;
+};
+
+struct	Shield
+{
+	float	power = 0.f;
+};
+
+struct	Docked {};
+
+struct	Fuel
+{
+	float	amount = 0.f;
+};
+
+namespace dpl
+{
+	template<>
+	struct	SparseStorage_of<Shield> : public std::true_type {};
+
+	template<>
+	struct	Description_of<Ship>
+	{
+		using BaseType			= Ship;
+		using ParentTypes		= dpl::TypeList<>;
+		using ChildTypes		= dpl::TypeList<>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<Hull, Shield>;
+		using TagTypes			= dpl::TypeList<Docked>;
+	};
+
+	template<>
+	struct	Description_of<Node>
+	{
+		using BaseType			= Node;
+		using ParentTypes		= dpl::TypeList<Node>;
+		using ChildTypes		= dpl::TypeList<Node>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<>;
+	};
+
+	template<>
+	struct	Description_of<Carrier>
+	{
+		using BaseType			= Carrier;
+		using ParentTypes		= dpl::TypeList<>;
+		using ChildTypes		= dpl::TypeList<Drone, Pilot>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<>;
+	};
+
+	template<>
+	struct	Description_of<Drone>
+	{
+		using BaseType			= Drone;
+		using ParentTypes		= dpl::TypeList<Carrier>;
+		using ChildTypes		= dpl::TypeList<>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<Fuel>;
+	};
+
+	template<>
+	struct	Description_of<Pilot>
+	{
+		using BaseType			= Pilot;
+		using ParentTypes		= dpl::TypeList<Carrier>;
+		using ChildTypes		= dpl::TypeList<>;
+		using PartnerTypes		= dpl::TypeList<>;
+		using ComponentTypes	= dpl::TypeList<>;
+	};
+
+	template<>
+	struct	Relation_between<Carrier, Drone> : public Relation<ONE_TO_MANY, STRONG_DEPENDENCY, CONTIGUOUS_STORAGE> {};
+
+	template<>
+	struct	Relation_between<Carrier, Pilot> : public Relation<ONE_TO_SPECIFIC_NUMBER<2>, WEAK_DEPENDENCY> {};
+}
+
+DEFINE_SIMPLE_ENTITY(Ship);
+DEFINE_SIMPLE_ENTITY(Drone);
+DEFINE_SIMPLE_ENTITY(Pilot);
+
+class	Node final : public dpl::Entity<Node>
+{
+public:		// [DATA]
+	uint32_t		depth = 0;
+
+public:		// [LIFECYCLE]
+	CLASS_CTOR		Node(				const dpl::Origin&	ORIGIN)
+		: Entity(ORIGIN)
+	{
+
+	}
+
+	CLASS_CTOR		Node(				Node&&				other) noexcept = default;
+	Node&			operator=(			Node&&				other) noexcept = default;
+
+public:		// [FUNCTIONS]
+	bool			attach(				Node&				child)
+	{
+		return Entity::add_child(child);
+	}
+};
+
+class	Carrier final : public dpl::Entity<Carrier>
+{
+public:		// [LIFECYCLE]
+	CLASS_CTOR		Carrier(			const dpl::Origin&	ORIGIN)
+		: Entity(ORIGIN)
+	{
+
+	}
+
+	CLASS_CTOR		Carrier(			Carrier&&			other) noexcept = default;
+	Carrier&		operator=(			Carrier&&			other) noexcept = default;
+
+public:		// [FUNCTIONS]
+	template<typename ChildT>
+	bool			attach(				ChildT&				child)
+	{
+		return Entity::add_child(child);
+	}
+};
+
+
+// test harness
+namespace
+{
+	uint32_t g_numFailed = 0;
+
+	void			check(			const bool			bPASSED,
+									const char*			WHAT)
+	{
+		if(bPASSED) return;
+		std::fprintf(stderr, "FAILED: %s\n", WHAT);
+		++g_numFailed;
+	}
+
+	std::string		entity_name(	const char*			PREFIX,
+									const uint32_t		INDEX)
+	{
+		return PREFIX + std::to_string(INDEX);
+	}
+
+	// Fresh world with the services required by the entity system.
+	struct	World
+	{
+		dpl::Multition		world;
+		dpl::Logger			logger;
+		dpl::EntityManager	manager;
+
+		World()
+			: logger(world)
+			, manager(world)
+		{
+
+		}
+	};
+
+
+	// Sparse components are stored only for the entities that were given one, statistics are collected for their pack too.
+	void			test_sparse_components()
+	{
+		World test;
+		for(uint32_t index = 0; index < 10; ++index)
+		{
+			Ship& ship = test.manager.create<Ship>(dpl::Name(dpl::Name::UNIQUE, entity_name("ship", index)));
+			ship.get_component<Hull>().integrity = (float)index;
+			if(index % 3 == 0) ship.add_component<Shield>().power = (float)index;
+		}
+
+		dpl::EntityPack_of<Ship>& ships = dpl::EntityPack_of<Ship>::ref();
+		check(ships.size() == 10, "sparse: all ships are created");
+		check(ships.sparse_row<Shield>().size() == 4, "sparse: only shielded ships store the component");
+
+		Ship* shielded = ships.find(entity_name("ship", 3));
+		check(shielded && shielded->has_component<Shield>() && shielded->find_component<Shield>()->power == 3.f, "sparse: component keeps its value");
+		check(shielded && shielded->remove_component<Shield>() && !shielded->find_component<Shield>(), "sparse: removed component is not found");
+
+		float sumOfPowers = 0.f;
+		ships.for_each_owner<Shield>([&](Ship& ship, Shield& shield)
+		{
+			check(ship.get_component<Hull>().integrity == shield.power, "sparse: owner is paired with its own component");
+			sumOfPowers += shield.power;
+		});
+		check(sumOfPowers == 0.f + 6.f + 9.f, "sparse: each remaining owner is visited once");
+
+		ships.destroy(*ships.find(entity_name("ship", 6)));
+		check(ships.sparse_row<Shield>().size() == 2, "sparse: component is removed with its entity");
+
+		const std::vector<dpl::EntityPack::Stats> STATS = test.manager.collect_stats();
+		check(STATS.size() == 1 && STATS[0].numEntities == 9 && STATS[0].numSparseRows == 1 && STATS[0].numSparseComponents == 2, "sparse: statistics count entities and sparse components");
+	}
+
+	// Reservation for the next frame covers component rows, not only the entities.
+	void			test_reserve_for_next_frame()
+	{
+		World test;
+		for(uint32_t index = 0; index < 100; ++index)
+		{
+			test.manager.create<Ship>(dpl::Name(dpl::Name::UNIQUE, entity_name("ship", index)));
+		}
+		test.manager.reserve_for_next_frame();
+
+		const dpl::EntityPack_of<Ship>& SHIPS = dpl::EntityPack_of<Ship>::ref();
+		check(SHIPS.row<Hull>().capacity() >= 200, "reserve: component row is reserved for the expected entities");
+	}
+
+	// Forked rows share their pages until one of the worlds modifies them, reads do not copy anything.
+	void			test_fork_isolation()
+	{
+		constexpr uint32_t NUM_SHIPS = 3 * dpl::SharedPages<Hull>::PAGE_SIZE;
+
+		World source;
+		for(uint32_t index = 0; index < NUM_SHIPS; ++index)
+		{
+			source.manager.create<Ship>(dpl::Name(dpl::Name::UNIQUE, entity_name("ship", index))).get_component<Hull>().integrity = (float)index;
+		}
+
+		World fork;
+		check(dpl::Multition::current() == &source.world, "fork: creating another world keeps the thread bound to its world");
+		source.manager.fork_to(fork.manager);
+
+		const uint32_t	LAST		= NUM_SHIPS - 1;
+		const Hull*		SOURCE_LAST	= nullptr;
+		{dpl::ScopedWorld bound(source.world);
+			const dpl::EntityPack_of<Ship>& SHIPS = dpl::EntityPack_of<Ship>::ref();
+			SOURCE_LAST = SHIPS.row<Hull>().at(LAST);
+		}
+
+		{dpl::ScopedWorld bound(fork.world);
+			dpl::EntityPack_of<Ship>& ships = dpl::EntityPack_of<Ship>::ref();
+			check(ships.size() == NUM_SHIPS, "fork: every entity is copied");
+
+			const dpl::EntityPack_of<Ship>& SHIPS = ships;
+			check(SHIPS.row<Hull>().at(LAST) == SOURCE_LAST, "fork: single read does not copy the shared page");
+
+			float sumOfIntegrities = 0.f;
+			SHIPS.row<Hull>().read_each([&](const Hull& HULL){ sumOfIntegrities += HULL.integrity; });
+			check(sumOfIntegrities == (float)(NUM_SHIPS * (NUM_SHIPS - 1) / 2), "fork: whole row is read from the shared pages");
+			check(SHIPS.row<Hull>().at(LAST) == SOURCE_LAST, "fork: whole row read does not copy the shared pages");
+
+			ships.find(entity_name("ship", 5))->get_component<Hull>().integrity = -1.f;
+			check(SHIPS.row<Hull>().at(LAST) == SOURCE_LAST, "fork: write copies only the page of the modified component");
+
+			ships.for_each([](dpl::EntityPackView<Ship>& view)
+			{
+				for(uint32_t index = 0; index < view.numEntities(); ++index) view.component_at<Hull>(index).integrity += 1000.f;
+			});
+			check(ships.find(entity_name("ship", LAST))->get_component<Hull>().integrity == 1000.f + LAST, "fork: view modifies the forked components");
+		}
+
+		{dpl::ScopedWorld bound(source.world);
+			dpl::EntityPack_of<Ship>& ships = dpl::EntityPack_of<Ship>::ref();
+			check(ships.find(entity_name("ship", 5))->get_component<Hull>().integrity == 5.f, "fork: source does not see writes of the fork");
+			check(ships.find(entity_name("ship", LAST))->get_component<Hull>().integrity == (float)LAST, "fork: source does not see modifications of the fork view");
+
+			ships.find(entity_name("ship", 7))->get_component<Hull>().integrity = -7.f;
+			source.manager.create<Ship>(dpl::Name(dpl::Name::UNIQUE, entity_name("ship", NUM_SHIPS))); //<-- Resize detaches the pages.
+			check(ships.find(entity_name("ship", 7))->get_component<Hull>().integrity == -7.f && ships.size() == NUM_SHIPS + 1, "fork: source keeps its writes after the resize");
+		}
+
+		{dpl::ScopedWorld bound(fork.world);
+			dpl::EntityPack_of<Ship>& ships = dpl::EntityPack_of<Ship>::ref();
+			check(ships.find(entity_name("ship", 7))->get_component<Hull>().integrity == 1007.f, "fork: fork does not see writes of the source");
+			check(ships.size() == NUM_SHIPS, "fork: fork does not see entities created by the source");
+		}
+	}
+
+	// Ships are created with Hull::integrity equal to the index in their name.
+	dpl::EntityPack_of<Ship>&	create_ships(	dpl::EntityManager&	manager,
+												const uint32_t		NUM_SHIPS)
+	{
+		for(uint32_t index = 0; index < NUM_SHIPS; ++index)
+		{
+			manager.create<Ship>(dpl::Name(dpl::Name::UNIQUE, entity_name("ship", index))).get_component<Hull>().integrity = (float)index;
+		}
+		return dpl::EntityPack_of<Ship>::ref();
+	}
+
+	// Each remaining entity keeps its own components when others are destroyed, the last entity fills the hole.
+	void			test_order_and_counts()
+	{
+		World test;
+		dpl::EntityPack_of<Ship>& ships = create_ships(test.manager, 10);
+		check(ships.size() == 10 && ships.numActive() == 10, "order: all ships are created active");
+		check(ships.get(9).name() == "ship9", "order: entities are appended in the order of creation");
+
+		ships.destroy(entity_name("ship", 2));
+		check(ships.size() == 9 && !ships.find(entity_name("ship", 2)), "order: destroyed entity is not found");
+		check(ships.get(2).name() == "ship9", "order: last entity fills the hole of the destroyed one");
+
+		bool bCOMPONENTS_MATCH = true;
+		uint32_t numVisited = 0;
+		ships.for_each([&](Ship& ship)
+		{
+			bCOMPONENTS_MATCH &= (ship.get_component<Hull>().integrity == std::stof(ship.name().substr(4)));
+			++numVisited;
+		});
+		check(numVisited == 9 && bCOMPONENTS_MATCH, "order: components move together with their entities");
+
+		ships.destroy_all();
+		check(ships.size() == 0 && ships.numActive() == 0, "order: destroy_all removes every entity");
+	}
+
+	// Inactive entities are moved after the active ones and skipped by the iteration, but keep their state.
+	void			test_set_active()
+	{
+		World test;
+		dpl::EntityPack_of<Ship>& ships = create_ships(test.manager, 10);
+
+		for(uint32_t index = 0; index < 10; index += 3)
+		{
+			check(ships.set_active(*ships.find(entity_name("ship", index)), false), "active: entity is deactivated");
+		}
+		check(!ships.set_active(*ships.find(entity_name("ship", 0)), false), "active: inactive entity is not deactivated twice");
+		check(ships.size() == 10 && ships.numActive() == 6, "active: deactivated entities are counted separately");
+
+		bool bONLY_ACTIVE = true;
+		uint32_t numVisited = 0;
+		ships.for_each([&](const Ship& SHIP)
+		{
+			bONLY_ACTIVE &= (std::stoul(SHIP.name().substr(4)) % 3 != 0);
+			++numVisited;
+		});
+		check(numVisited == 6 && bONLY_ACTIVE, "active: iteration skips inactive entities");
+
+		bool bPARTITIONED = true;
+		for(uint32_t index = 0; index < ships.size(); ++index)
+		{
+			bPARTITIONED &= (ships.is_active_at(index) == (index < ships.numActive()));
+		}
+		check(bPARTITIONED, "active: active entities are stored before inactive ones");
+
+		Ship& revived = *ships.find(entity_name("ship", 3));
+		check(ships.set_active(revived, true) && ships.is_active(*ships.find(entity_name("ship", 3))), "active: entity is reactivated");
+		check(ships.find(entity_name("ship", 3))->get_component<Hull>().integrity == 3.f, "active: components follow the entity when it changes state");
+		check(ships.find(entity_name("ship", 9))->get_component<Hull>().integrity == 9.f, "active: inactive entity keeps its components");
+	}
+
+	// Tag bits follow their entities when entities are moved.
+	void			test_tags()
+	{
+		World test;
+		dpl::EntityPack_of<Ship>& ships = create_ships(test.manager, 100);
+		for(uint32_t index = 0; index < 100; index += 2)
+		{
+			ships.find(entity_name("ship", index))->set_tag<Docked>();
+		}
+		check(ships.tag_row<Docked>().count() == 50, "tags: one bit is set per tagged entity");
+
+		ships.destroy(entity_name("ship", 0)); //<-- Untagged ship99 is moved into the hole.
+		ships.find(entity_name("ship", 2))->set_tag<Docked>(false);
+		check(!ships.find(entity_name("ship", 99))->has_tag<Docked>() && ships.find(entity_name("ship", 98))->has_tag<Docked>(), "tags: moved entity keeps its tag");
+
+		bool bONLY_TAGGED = true;
+		uint32_t numTagged = 0;
+		ships.for_each_tagged<Docked>([&](Ship& ship)
+		{
+			bONLY_TAGGED &= (std::stoul(ship.name().substr(4)) % 2 == 0) && ship.has_tag<Docked>();
+			++numTagged;
+		});
+		check(numTagged == 48 && bONLY_TAGGED, "tags: iteration visits only tagged entities");
+
+		ships.set_active(*ships.find(entity_name("ship", 4)), false);
+		numTagged = 0;
+		ships.for_each_tagged<Docked>([&](Ship&){ ++numTagged; });
+		check(numTagged == 47, "tags: inactive entities are skipped");
+	}
+
+	// Address inside of the entity resolves to its identity, other addresses resolve to the false identity.
+	void			test_identity_from_address()
+	{
+		World test;
+		dpl::EntityPack_of<Ship>& ships = create_ships(test.manager, 10);
+
+		const Ship&	SHIP	= *ships.find(entity_name("ship", 7));
+		const char*	INSIDE	= reinterpret_cast<const char*>(&SHIP) + sizeof(Ship) - 1;
+		check(test.manager.identity_from_address(&SHIP).name() == "ship7", "identity: entity address is resolved");
+		check(test.manager.identity_from_address(INSIDE).name() == "ship7", "identity: address inside of the entity is resolved");
+
+		const uint32_t LOCAL = 0;
+		check(&test.manager.identity_from_address(&LOCAL) == &dpl::EntityManager::false_identity(), "identity: unrelated address is not resolved");
+	}
+
+	// Contiguous children are accessed by index, handles stay valid when the children are relocated.
+	void			test_contiguous_children()
+	{
+		World test;
+		Carrier& carrier = test.manager.create<Carrier>(dpl::Name(dpl::Name::UNIQUE, "carrier0"));
+		for(uint32_t index = 0; index < 5; ++index)
+		{
+			carrier.attach(test.manager.create<Drone>(dpl::Name(dpl::Name::UNIQUE, entity_name("drone", index))));
+		}
+		check(carrier.numChildren<Drone>() == 5 && carrier.children<Drone>().size() == 5, "contiguous: children are counted");
+
+		for(uint32_t index = 5; index < 1000; ++index)
+		{
+			test.manager.create<Drone>(dpl::Name(dpl::Name::UNIQUE, entity_name("drone", index))); //<-- Relocates the drones.
+		}
+
+		bool bIN_ORDER = true;
+		for(uint32_t index = 0; index < 5; ++index)
+		{
+			const Drone& DRONE = carrier.child_at<Drone>(index);
+			bIN_ORDER &= (DRONE.name() == entity_name("drone", index)) && (&DRONE.get_parent<Carrier>() == &carrier);
+		}
+		check(bIN_ORDER, "contiguous: children are stored in the order of adoption and survive relocation");
+
+		dpl::EntityPack_of<Drone>& drones = dpl::EntityPack_of<Drone>::ref();
+		drones.destroy(entity_name("drone", 1));
+		uint32_t numVisited = 0;
+		carrier.for_each_child<Drone>([&](const Drone& DRONE)
+		{
+			check(DRONE.name() != "drone1", "contiguous: destroyed child is removed from its parent");
+			++numVisited;
+		});
+		check(carrier.numChildren<Drone>() == 4 && numVisited == 4, "contiguous: destroyed child is not counted");
+	}
+
+	// Parent of the ONE_TO_SPECIFIC_NUMBER relation refuses children over the limit.
+	void			test_specific_number_of_children()
+	{
+		World test;
+		Carrier& carrier = test.manager.create<Carrier>(dpl::Name(dpl::Name::UNIQUE, "carrier0"));
+		for(uint32_t index = 0; index < 3; ++index)
+		{
+			test.manager.create<Pilot>(dpl::Name(dpl::Name::UNIQUE, entity_name("pilot", index)));
+		}
+
+		dpl::EntityPack_of<Pilot>& pilots = dpl::EntityPack_of<Pilot>::ref(); //<-- Taken after the creation, pilots could be relocated.
+		Pilot& first	= pilots.get(entity_name("pilot", 0));
+		Pilot& second	= pilots.get(entity_name("pilot", 1));
+		Pilot& third	= pilots.get(entity_name("pilot", 2));
+
+		check(carrier.attach(first) && carrier.attach(second), "specific number: children up to the limit are adopted");
+		check(!carrier.can_have_another_child<Pilot>() && !carrier.attach(third), "specific number: child over the limit is refused");
+		check(carrier.numChildren<Pilot>() == 2 && !third.has_parent<Carrier>(), "specific number: refused child stays an orphan");
+	}
+
+	// Destruction of the parent destroys its strongly dependent children (batched), weakly dependent children are only released.
+	void			test_hierarchy_destroy()
+	{
+		World test;
+		for(uint32_t carrierIndex = 0; carrierIndex < 2; ++carrierIndex)
+		{
+			Carrier& carrier = test.manager.create<Carrier>(dpl::Name(dpl::Name::UNIQUE, entity_name("carrier", carrierIndex)));
+			for(uint32_t index = 0; index < 10; ++index)
+			{
+				carrier.attach(test.manager.create<Drone>(dpl::Name(dpl::Name::UNIQUE, entity_name("drone", carrierIndex * 10 + index))));
+			}
+			carrier.attach(test.manager.create<Pilot>(dpl::Name(dpl::Name::UNIQUE, entity_name("pilot", carrierIndex))));
+		}
+
+		dpl::EntityPack_of<Carrier>&	carriers	= dpl::EntityPack_of<Carrier>::ref();
+		dpl::EntityPack_of<Drone>&		drones		= dpl::EntityPack_of<Drone>::ref();
+		dpl::EntityPack_of<Pilot>&		pilots		= dpl::EntityPack_of<Pilot>::ref();
+
+		dpl::EntityPack::DestructionBatch batch;
+		batch.add_hierarchy(carriers.get(entity_name("carrier", 0)));
+		check(batch.size() == 11, "hierarchy: batch contains the parent and its strongly dependent children");
+		batch.destroy();
+
+		check(carriers.size() == 1 && drones.size() == 10 && pilots.size() == 2, "hierarchy: only the strongly dependent children are destroyed");
+		check(!drones.find(entity_name("drone", 0)) && drones.find(entity_name("drone", 10)), "hierarchy: children of the other parent are kept");
+		check(!pilots.get(entity_name("pilot", 0)).has_parent<Carrier>(), "hierarchy: weakly dependent child loses its parent");
+
+		bool bPARENTS_MATCH = true;
+		drones.for_each([&](const Drone& DRONE)
+		{
+			bPARENTS_MATCH &= DRONE.has_parent<Carrier>() && (DRONE.get_parent<Carrier>().name() == "carrier1");
+		});
+		check(bPARENTS_MATCH, "hierarchy: relations of the moved children are kept");
+
+		carriers.destroy(entity_name("carrier", 1));
+		check(carriers.size() == 0 && drones.size() == 0 && pilots.size() == 2, "hierarchy: destroy of the pack entity destroys its hierarchy");
+	}
+
+	// Node at index i is a child of the node at index (i-1)/BRANCHING, so its depth is known up front.
+	void			create_tree(	dpl::EntityManager&	manager,
+									const uint32_t		NUM_NODES,
+									const uint32_t		BRANCHING)
+	{
+		for(uint32_t index = 0; index < NUM_NODES; ++index)
+		{
+			manager.create<Node>(dpl::Name(dpl::Name::UNIQUE, entity_name("node", index)));
+		}
+
+		dpl::EntityPack_of<Node>& nodes = dpl::EntityPack_of<Node>::ref(); //<-- Pack is created with the first entity.
+
+		for(uint32_t index = 1; index < NUM_NODES; ++index)
+		{
+			nodes.find(entity_name("node", (index - 1) / BRANCHING))->attach(*nodes.find(entity_name("node", index)));
+		}
+	}
+
+	// Each child is invoked after its parent, so the depth accumulates from the root.
+	void			check_levels(	dpl::EntityManager&	manager,
+									dpl::ParallelPhase&	phase,
+									const uint32_t		NUM_CHILDREN,
+									const char*			WHAT)
+	{
+		dpl::EntityPack_of<Node>& nodes = dpl::EntityPack_of<Node>::ref();
+		nodes.for_each([](dpl::EntityPackView<Node>& view)
+		{
+			for(uint32_t index = 0; index < view.numEntities(); ++index) view.entity_at(index).depth = 0;
+		});
+
+		std::atomic<uint32_t> numInvoked(0);
+		manager.for_each_level<Node, Node>(phase, [&](Node& node)
+		{
+			node.depth = node.get_parent<Node>().depth + 1;
+			++numInvoked;
+		});
+
+		bool bDEPTHS_MATCH = true;
+		for(uint32_t index = 0; index < nodes.size(); ++index)
+		{
+			const Node& NODE = nodes.get(index);
+			const uint32_t NAME_INDEX = (uint32_t)std::stoul(NODE.name().substr(4));
+			uint32_t expected = 0;
+			for(uint32_t ancestor = NAME_INDEX; ancestor > 0; ancestor = (ancestor - 1) / 4) ++expected;
+			bDEPTHS_MATCH &= (NODE.depth == expected);
+		}
+		check(numInvoked == NUM_CHILDREN && bDEPTHS_MATCH, WHAT);
+	}
+
+	// Levels are cached until the hierarchy changes, unrelated packs do not invalidate them.
+	void			test_hierarchy_levels()
+	{
+		World				test;
+		dpl::ParallelPhase	phase(4);
+		create_tree(test.manager, 1000, 4);
+		check_levels(test.manager, phase, 999, "levels: every child is invoked once, after its parent");
+
+		for(uint32_t index = 0; index < 100; ++index)
+		{
+			test.manager.create<Ship>(dpl::Name(dpl::Name::UNIQUE, entity_name("ship", index)));
+		}
+		check_levels(test.manager, phase, 999, "levels: unrelated entities do not change the levels");
+
+		dpl::EntityPack_of<Node>& nodes = dpl::EntityPack_of<Node>::ref();
+		test.manager.create<Node>(dpl::Name(dpl::Name::UNIQUE, entity_name("node", 1000)));
+		nodes.find(entity_name("node", 249))->attach(*nodes.find(entity_name("node", 1000)));
+		check_levels(test.manager, phase, 1000, "levels: adopted child is included after the hierarchy changed");
+	}
+
+#ifdef _DEBUG
+	// Returns the message of the conflict detected by the other thread, or an empty string.
+	template<typename AccessT>
+	std::string		conflict_in_other_thread(	const char*		CALLER,
+												AccessT&&		access)
+	{
+		dpl::Multition* const	WORLD = dpl::Multition::current();
+		std::string				message;
+		std::thread other([&]()
+		{
+			WORLD->bind();
+			const dpl::AccessCaller CALLER_LABEL(CALLER);
+			try { access(); }
+			catch(const dpl::GeneralException& ERROR) { message = ERROR.what(); }
+		});
+		other.join();
+		return message;
+	}
+
+	// Single components are checked against the scopes of the row and of their column, conflicts name both callers.
+	void			test_component_access()
+	{
+		World test;
+		dpl::EntityPack_of<Ship>& ships = create_ships(test.manager, 4);
+		auto write_hull = [&](const uint32_t INDEX){ return [&ships, INDEX](){ ships.get(INDEX).get_component<Hull>().integrity = 0.f; }; };
+
+		{
+			const dpl::AccessCaller	CALLER("Renderer");
+			const auto				READ = ships.row<Hull>().scoped_read("draw hulls");
+			const std::string		MESSAGE = conflict_in_other_thread("Physics", write_hull(1));
+			check(MESSAGE.find("Physics") != std::string::npos && MESSAGE.find("Renderer: draw hulls") != std::string::npos, "access: component write conflicts with the row reader of another thread");
+		}
+
+		{
+			const auto WRITE = ships.row<Hull>().scoped_write_at(0, "repair");
+			check(conflict_in_other_thread("Physics", write_hull(1)).empty(), "access: components of different columns are written in parallel");
+			check(!conflict_in_other_thread("Physics", write_hull(0)).empty(), "access: component write conflicts with the column writer of another thread");
+		}
+	}
+#endif // _DEBUG
+}
+
+
+int main()
+{
+	test_order_and_counts();
+	test_set_active();
+	test_tags();
+	test_identity_from_address();
+	test_sparse_components();
+	test_reserve_for_next_frame();
+	test_fork_isolation();
+	test_hierarchy_levels();
+	test_contiguous_children();
+	test_specific_number_of_children();
+	test_hierarchy_destroy();
+#ifdef _DEBUG
+	test_component_access();
+#endif // _DEBUG
+
+	if(g_numFailed > 0)
+		return 1;
+
+	std::fprintf(stderr, "all entity tests passed\n");
+	return 0;
+}